@@ -0,0 +1,43 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "compressed_file_writer.h"
+
+#include "lmptype.h"
+#include "memory.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ----------------------------------------------------------------------
+   replace the first length chars of buffer with an independent compressed
+   stream, used by dumps in multistream mode to compress on every MPI rank
+   buffer is allocated by Memory and grown if the stream does not fit
+   return number of bytes in the stream or -1 if it exceeds MAXSMALLINT
+------------------------------------------------------------------------- */
+
+int CompressedFileWriter::compress_buffer(char *&buffer, int &maxbuffer, int length,
+                                          Memory *memory) const
+{
+  std::string stream = compress(buffer, length);
+  if (stream.size() > (size_t) MAXSMALLINT) return -1;
+
+  int nbytes = stream.size();
+  if (nbytes > maxbuffer) {
+    maxbuffer = nbytes;
+    memory->grow(buffer, maxbuffer, "dump:sbuf");
+  }
+  memcpy(buffer, stream.data(), nbytes);
+  return nbytes;
+}
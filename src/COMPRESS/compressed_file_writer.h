@@ -0,0 +1,31 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_COMPRESSED_FILE_WRITER_H
+#define LMP_COMPRESSED_FILE_WRITER_H
+
+#include "file_writer.h"
+
+#include <string>
+
+namespace LAMMPS_NS {
+class Memory;
+
+class CompressedFileWriter : public FileWriter {
+ public:
+  virtual std::string compress(const void *buffer, size_t length) const = 0;
+  int compress_buffer(char *&buffer, int &maxbuffer, int length, Memory *memory) const;
+};
+}    // namespace LAMMPS_NS
+
+#endif
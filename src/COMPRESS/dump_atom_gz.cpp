@@ -24,6 +24,8 @@ using namespace LAMMPS_NS;
 
 DumpAtomGZ::DumpAtomGZ(LAMMPS *lmp, int narg, char **arg) : DumpAtom(lmp, narg, arg)
 {
+  async_allow = 0;
+  multistream_flag = 0;
   if (!compressed) error->all(FLERR, "Dump atom/gz only writes compressed files");
 }
 
@@ -115,7 +117,10 @@ void DumpAtomGZ::write_header(bigint ndump)
 void DumpAtomGZ::write_data(int n, double *mybuf)
 {
   if (buffer_flag == 1) {
-    writer.write(mybuf, n);
+    if (multistream_flag)
+      writer.write_compressed(mybuf, n);
+    else
+      writer.write(mybuf, n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -147,6 +152,9 @@ void DumpAtomGZ::write_data(int n, double *mybuf)
 
 void DumpAtomGZ::write()
 {
+  if (multistream_flag && !buffer_flag)
+    error->all(FLERR, "Dump atom/gz multistream yes requires dump_modify buffer yes");
+
   DumpAtom::write();
   if (filewriter) {
     if (multifile) {
@@ -157,6 +165,24 @@ void DumpAtomGZ::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   in multistream mode, compress my formatted lines into an independent stream
+   so the compression is done in parallel and the filewriter only copies bytes
+------------------------------------------------------------------------- */
+
+int DumpAtomGZ::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpAtom::convert_string(n, mybuf);
+  if (!multistream_flag || nchars <= 0) return nchars;
+
+  try {
+    nchars = writer.compress_buffer(sbuf, maxsbuf, nchars, memory);
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
+  }
+  return nchars;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpAtomGZ::modify_param(int narg, char **arg)
@@ -164,7 +190,12 @@ int DumpAtomGZ::modify_param(int narg, char **arg)
   int consumed = DumpAtom::modify_param(narg, arg);
   if (consumed == 0) {
     try {
-      if (strcmp(arg[0], "compression_level") == 0) {
+      if (strcmp(arg[0], "multistream") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        multistream_flag = utils::logical(FLERR, arg[1], false, lmp);
+        writer.setMultiStream(multistream_flag == 1);
+        return 2;
+      } else if (strcmp(arg[0], "compression_level") == 0) {
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
         writer.setCompressionLevel(compression_level);
@@ -37,11 +37,13 @@ class DumpAtomZstd : public DumpAtom {
 
  protected:
   ZstdFileWriter writer;
+  int multistream_flag;    // 1 if each proc compresses its own data, else 0
 
   void openfile() override;
   void write_header(bigint) override;
   void write_data(int, double *) override;
   void write() override;
+  int convert_string(int, double *) override;
 
   int modify_param(int, char **) override;
 };
@@ -26,6 +26,7 @@ using namespace LAMMPS_NS;
 
 DumpCFGGZ::DumpCFGGZ(LAMMPS *lmp, int narg, char **arg) : DumpCFG(lmp, narg, arg)
 {
+  async_allow = 0;
   if (!compressed) error->all(FLERR, "Dump cfg/gz only writes compressed files");
 }
 
@@ -24,6 +24,8 @@ using namespace LAMMPS_NS;
 
 DumpCustomGZ::DumpCustomGZ(LAMMPS *lmp, int narg, char **arg) : DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+  multistream_flag = 0;
   if (!compressed) error->all(FLERR, "Dump custom/gz only writes compressed files");
 }
 
@@ -113,7 +115,10 @@ void DumpCustomGZ::write_header(bigint ndump)
 void DumpCustomGZ::write_data(int n, double *mybuf)
 {
   if (buffer_flag == 1) {
-    writer.write(mybuf, n);
+    if (multistream_flag)
+      writer.write_compressed(mybuf, n);
+    else
+      writer.write(mybuf, n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -147,6 +152,9 @@ void DumpCustomGZ::write_data(int n, double *mybuf)
 
 void DumpCustomGZ::write()
 {
+  if (multistream_flag && !buffer_flag)
+    error->all(FLERR, "Dump custom/gz multistream yes requires dump_modify buffer yes");
+
   DumpCustom::write();
   if (filewriter) {
     if (multifile) {
@@ -157,6 +165,24 @@ void DumpCustomGZ::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   in multistream mode, compress my formatted lines into an independent stream
+   so the compression is done in parallel and the filewriter only copies bytes
+------------------------------------------------------------------------- */
+
+int DumpCustomGZ::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpCustom::convert_string(n, mybuf);
+  if (!multistream_flag || nchars <= 0) return nchars;
+
+  try {
+    nchars = writer.compress_buffer(sbuf, maxsbuf, nchars, memory);
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
+  }
+  return nchars;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpCustomGZ::modify_param(int narg, char **arg)
@@ -164,7 +190,12 @@ int DumpCustomGZ::modify_param(int narg, char **arg)
   int consumed = DumpCustom::modify_param(narg, arg);
   if (consumed == 0) {
     try {
-      if (strcmp(arg[0], "compression_level") == 0) {
+      if (strcmp(arg[0], "multistream") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        multistream_flag = utils::logical(FLERR, arg[1], false, lmp);
+        writer.setMultiStream(multistream_flag == 1);
+        return 2;
+      } else if (strcmp(arg[0], "compression_level") == 0) {
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         int compression_level = utils::inumeric(FLERR, arg[1], false, lmp);
         writer.setCompressionLevel(compression_level);
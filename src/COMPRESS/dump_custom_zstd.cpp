@@ -33,6 +33,8 @@ using namespace LAMMPS_NS;
 DumpCustomZstd::DumpCustomZstd(LAMMPS *lmp, int narg, char **arg) :
   DumpCustom(lmp, narg, arg)
 {
+  async_allow = 0;
+  multistream_flag = 0;
   if (!compressed)
     error->all(FLERR,"Dump custom/zstd only writes compressed files");
 }
@@ -131,7 +133,10 @@ void DumpCustomZstd::write_header(bigint ndump)
 void DumpCustomZstd::write_data(int n, double *mybuf)
 {
   if (buffer_flag == 1) {
-    writer.write(mybuf, n);
+    if (multistream_flag)
+      writer.write_compressed(mybuf, n);
+    else
+      writer.write(mybuf, n);
   } else {
     constexpr size_t VBUFFER_SIZE = 256;
     char vbuffer[VBUFFER_SIZE];
@@ -165,6 +170,9 @@ void DumpCustomZstd::write_data(int n, double *mybuf)
 
 void DumpCustomZstd::write()
 {
+  if (multistream_flag && !buffer_flag)
+    error->all(FLERR, "Dump custom/zstd multistream yes requires dump_modify buffer yes");
+
   DumpCustom::write();
   if (filewriter) {
     if (multifile) {
@@ -177,6 +185,24 @@ void DumpCustomZstd::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   in multistream mode, compress my formatted lines into an independent stream
+   so the compression is done in parallel and the filewriter only copies bytes
+------------------------------------------------------------------------- */
+
+int DumpCustomZstd::convert_string(int n, double *mybuf)
+{
+  int nchars = DumpCustom::convert_string(n, mybuf);
+  if (!multistream_flag || nchars <= 0) return nchars;
+
+  try {
+    nchars = writer.compress_buffer(sbuf, maxsbuf, nchars, memory);
+  } catch (FileWriterException &e) {
+    error->one(FLERR, e.what());
+  }
+  return nchars;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int DumpCustomZstd::modify_param(int narg, char **arg)
@@ -184,7 +210,12 @@ int DumpCustomZstd::modify_param(int narg, char **arg)
   int consumed = DumpCustom::modify_param(narg, arg);
   if (consumed == 0) {
     try {
-      if (strcmp(arg[0], "checksum") == 0) {
+      if (strcmp(arg[0], "multistream") == 0) {
+        if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
+        multistream_flag = utils::logical(FLERR, arg[1], false, lmp);
+        writer.setMultiStream(multistream_flag == 1);
+        return 2;
+      } else if (strcmp(arg[0], "checksum") == 0) {
         if (narg < 2) error->all(FLERR, "Illegal dump_modify command");
         writer.setChecksum(utils::logical(FLERR, arg[1], false, lmp) == 1);
         return 2;
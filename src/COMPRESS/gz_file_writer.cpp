@@ -21,7 +21,10 @@
 
 using namespace LAMMPS_NS;
 
-GzFileWriter::GzFileWriter() : compression_level(Z_BEST_COMPRESSION), gzFp(nullptr) {}
+GzFileWriter::GzFileWriter() :
+    compression_level(Z_BEST_COMPRESSION), multistream_flag(0), gzFp(nullptr), fp(nullptr)
+{
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -36,6 +39,14 @@ void GzFileWriter::open(const std::string &path, bool append)
 {
   if (isopen()) return;
 
+  // in multistream mode, each write is compressed into an independent gzip member
+
+  if (multistream_flag) {
+    fp = fopen(path.c_str(), append ? "ab" : "wb");
+    if (fp == nullptr) throw FileWriterException(fmt::format("Could not open file '{}'", path));
+    return;
+  }
+
   std::string mode;
   if (append) {
     mode = fmt::format("ab{}", mode, compression_level);
@@ -54,15 +65,70 @@ size_t GzFileWriter::write(const void *buffer, size_t length)
 {
   if (!isopen()) return 0;
 
+  if (multistream_flag) {
+    if (length == 0) return 0;
+    std::string member = compress(buffer, length);
+    fwrite(member.data(), sizeof(char), member.size(), fp);
+    return length;
+  }
+
   return gzwrite(gzFp, buffer, length);
 }
 
+/* ----------------------------------------------------------------------
+   write data that was already compressed with compress(), multistream mode only
+------------------------------------------------------------------------- */
+
+size_t GzFileWriter::write_compressed(const void *buffer, size_t length)
+{
+  if (!fp) return 0;
+
+  return fwrite(buffer, sizeof(char), length, fp);
+}
+
+/* ----------------------------------------------------------------------
+   compress buffer into a complete, independent gzip member
+   concatenated gzip members are a valid gzip file
+   does not require an open file, so can be used on any MPI rank
+------------------------------------------------------------------------- */
+
+std::string GzFileWriter::compress(const void *buffer, size_t length) const
+{
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+
+  // window bits of 15+16 selects gzip header and trailer
+
+  if (deflateInit2(&strm, compression_level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    throw FileWriterException("Could not initialize gzip compression");
+
+  std::string member(deflateBound(&strm, length), '\0');
+  strm.next_in = (Bytef *) buffer;
+  strm.avail_in = length;
+  strm.next_out = (Bytef *) &member[0];
+  strm.avail_out = member.size();
+
+  int rv = deflate(&strm, Z_FINISH);
+  member.resize(member.size() - strm.avail_out);
+  deflateEnd(&strm);
+
+  if (rv != Z_STREAM_END) throw FileWriterException("Error during gzip compression");
+  return member;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void GzFileWriter::flush()
 {
   if (!isopen()) return;
 
+  if (fp) {
+    fflush(fp);
+    return;
+  }
+
   gzflush(gzFp, Z_SYNC_FLUSH);
 }
 
@@ -72,6 +138,12 @@ void GzFileWriter::close()
 {
   if (!GzFileWriter::isopen()) return;
 
+  if (fp) {
+    fclose(fp);
+    fp = nullptr;
+    return;
+  }
+
   gzclose(gzFp);
   gzFp = nullptr;
 }
@@ -80,7 +152,7 @@ void GzFileWriter::close()
 
 bool GzFileWriter::isopen() const
 {
-  return gzFp;
+  return gzFp || fp;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -99,3 +171,11 @@ void GzFileWriter::setCompressionLevel(int level)
 
   compression_level = level;
 }
+
+/* ---------------------------------------------------------------------- */
+
+void GzFileWriter::setMultiStream(bool enabled)
+{
+  if (isopen()) throw FileWriterException("Multistream flag can not be changed while file is open");
+  multistream_flag = enabled ? 1 : 0;
+}
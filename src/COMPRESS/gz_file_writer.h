@@ -18,17 +18,19 @@
 #ifndef LMP_GZ_FILE_WRITER_H
 #define LMP_GZ_FILE_WRITER_H
 
-#include "file_writer.h"
+#include "compressed_file_writer.h"
 
 #include <string>
 #include <zlib.h>
 
 namespace LAMMPS_NS {
 
-class GzFileWriter : public FileWriter {
+class GzFileWriter : public CompressedFileWriter {
   int compression_level;
+  int multistream_flag;
 
   gzFile gzFp;    // file pointer for the compressed output stream
+  FILE *fp;       // file pointer for output of independent gzip members
  public:
   GzFileWriter();
   ~GzFileWriter() override;
@@ -39,6 +41,10 @@ class GzFileWriter : public FileWriter {
   bool isopen() const override;
 
   void setCompressionLevel(int level);
+  void setMultiStream(bool enabled);
+
+  std::string compress(const void *buffer, size_t length) const override;
+  size_t write_compressed(const void *buffer, size_t length);
 };
 }    // namespace LAMMPS_NS
 
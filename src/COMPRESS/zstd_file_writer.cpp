@@ -24,7 +24,7 @@
 using namespace LAMMPS_NS;
 
 ZstdFileWriter::ZstdFileWriter() :
-    compression_level(0), checksum_flag(1), cctx(nullptr), fp(nullptr)
+    compression_level(0), checksum_flag(1), multistream_flag(0), cctx(nullptr), fp(nullptr)
 {
   out_buffer_size = ZSTD_CStreamOutSize();
   out_buffer = new char[out_buffer_size];
@@ -73,6 +73,15 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
 {
   if (!isopen()) return 0;
 
+  // in multistream mode, each write is compressed into an independent frame
+
+  if (multistream_flag) {
+    if (length == 0) return 0;
+    std::string frame = compress(buffer, length);
+    fwrite(frame.data(), sizeof(char), frame.size(), fp);
+    return length;
+  }
+
   ZSTD_inBuffer input = {buffer, length, 0};
   ZSTD_EndDirective mode = ZSTD_e_continue;
 
@@ -85,12 +94,52 @@ size_t ZstdFileWriter::write(const void *buffer, size_t length)
   return length;
 }
 
+/* ----------------------------------------------------------------------
+   write data that was already compressed with compress(), multistream mode only
+------------------------------------------------------------------------- */
+
+size_t ZstdFileWriter::write_compressed(const void *buffer, size_t length)
+{
+  if (!isopen()) return 0;
+
+  return fwrite(buffer, sizeof(char), length, fp);
+}
+
+/* ----------------------------------------------------------------------
+   compress buffer into a complete, independent zstd frame
+   concatenated frames are a valid zstd file
+   does not require an open file, so can be used on any MPI rank
+------------------------------------------------------------------------- */
+
+std::string ZstdFileWriter::compress(const void *buffer, size_t length) const
+{
+  ZSTD_CCtx *fctx = ZSTD_createCCtx();
+  if (!fctx) throw FileWriterException("Could not create Zstd context");
+
+  ZSTD_CCtx_setParameter(fctx, ZSTD_c_compressionLevel, compression_level);
+  ZSTD_CCtx_setParameter(fctx, ZSTD_c_checksumFlag, checksum_flag);
+
+  std::string frame(ZSTD_compressBound(length), '\0');
+  size_t rv = ZSTD_compress2(fctx, &frame[0], frame.size(), buffer, length);
+  ZSTD_freeCCtx(fctx);
+
+  if (ZSTD_isError(rv))
+    throw FileWriterException(fmt::format("Error during Zstd compression: {}", ZSTD_getErrorName(rv)));
+  frame.resize(rv);
+  return frame;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void ZstdFileWriter::flush()
 {
   if (!isopen()) return;
 
+  if (multistream_flag) {
+    fflush(fp);
+    return;
+  }
+
   size_t remaining;
   ZSTD_inBuffer input = {nullptr, 0, 0};
   ZSTD_EndDirective mode = ZSTD_e_flush;
@@ -110,6 +159,14 @@ void ZstdFileWriter::close()
 {
   if (!ZstdFileWriter::isopen()) return;
 
+  if (multistream_flag) {
+    ZSTD_freeCCtx(cctx);
+    cctx = nullptr;
+    fclose(fp);
+    fp = nullptr;
+    return;
+  }
+
   size_t remaining;
   ZSTD_inBuffer input = {nullptr, 0, 0};
   ZSTD_EndDirective mode = ZSTD_e_end;
@@ -158,4 +215,12 @@ void ZstdFileWriter::setChecksum(bool enabled)
   checksum_flag = enabled ? 1 : 0;
 }
 
+/* ---------------------------------------------------------------------- */
+
+void ZstdFileWriter::setMultiStream(bool enabled)
+{
+  if (isopen()) throw FileWriterException("Multistream flag can not be changed while file is open");
+  multistream_flag = enabled ? 1 : 0;
+}
+
 #endif
@@ -20,7 +20,7 @@
 #ifndef LMP_ZSTD_FILE_WRITER_H
 #define LMP_ZSTD_FILE_WRITER_H
 
-#include "file_writer.h"
+#include "compressed_file_writer.h"
 
 #include <string>
 #include <zstd.h>
@@ -31,9 +31,10 @@
 
 namespace LAMMPS_NS {
 
-class ZstdFileWriter : public FileWriter {
+class ZstdFileWriter : public CompressedFileWriter {
   int compression_level;
   int checksum_flag;
+  int multistream_flag;
 
   ZSTD_CCtx *cctx;
   FILE *fp;
@@ -51,6 +52,10 @@ class ZstdFileWriter : public FileWriter {
 
   void setCompressionLevel(int level);
   void setChecksum(bool enabled);
+  void setMultiStream(bool enabled);
+
+  std::string compress(const void *buffer, size_t length) const override;
+  size_t write_compressed(const void *buffer, size_t length);
 };
 }    // namespace LAMMPS_NS
 
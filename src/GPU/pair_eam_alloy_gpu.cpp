@@ -65,6 +65,8 @@ PairEAMAlloyGPU::PairEAMAlloyGPU(LAMMPS *lmp) : PairEAM(lmp), gpu_mode(GPU_FORCE
 {
   one_coeff = 1;
   respa_enable = 0;
+  overlap_enable = 0;
+  full_enable = 0;
   reinitflag = 0;
   cpu_time = 0.0;
   suffix_flag |= Suffix::GPU;
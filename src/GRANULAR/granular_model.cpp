@@ -303,6 +303,30 @@ int GranularModel::mix_coeffs(GranularModel *g1, GranularModel *g2)
   return -1;
 }
 
+/* ----------------------------------------------------------------------
+   make this model an initialized, independent copy of another model,
+   so that per-contact data can be computed concurrently
+------------------------------------------------------------------------- */
+
+void GranularModel::copy_model(GranularModel *g)
+{
+  for (int i = 0; i < NSUBMODELS; i++) {
+    construct_sub_model(g->sub_models[i]->name, (SubModelType) i);
+    for (int j = 0; j < sub_models[i]->num_coeffs; j++)
+      sub_models[i]->coeffs[j] = g->sub_models[i]->coeffs[j];
+    sub_models[i]->coeffs_to_local();
+  }
+
+  limit_damping = g->limit_damping;
+  contact_type = g->contact_type;
+  init();
+
+  for (int i = 0; i < NSUBMODELS; i++)
+    sub_models[i]->history_index = g->sub_models[i]->history_index;
+  history_update = g->history_update;
+  dt = g->dt;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void GranularModel::write_restart(FILE *fp)
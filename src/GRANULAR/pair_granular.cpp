@@ -629,6 +629,7 @@ double PairGranular::init_one(int i, int j)
 void PairGranular::write_restart(FILE *fp)
 {
   int i,j;
+  write_restart_settings(fp);
   fwrite(&nmodels,sizeof(int),1,fp);
   for (i = 0; i < nmodels; i++) models_list[i]->write_restart(fp);
 
@@ -649,6 +650,7 @@ void PairGranular::write_restart(FILE *fp)
 
 void PairGranular::read_restart(FILE *fp)
 {
+  read_restart_settings(fp);
   allocate();
   int i,j;
   int me = comm->me;
@@ -679,6 +681,26 @@ void PairGranular::read_restart(FILE *fp)
   }
 }
 
+/* ----------------------------------------------------------------------
+   proc 0 writes to restart file
+------------------------------------------------------------------------- */
+
+void PairGranular::write_restart_settings(FILE *fp)
+{
+  fwrite(&cutoff_global,sizeof(double),1,fp);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads from restart file, bcasts
+------------------------------------------------------------------------- */
+
+void PairGranular::read_restart_settings(FILE *fp)
+{
+  if (comm->me == 0)
+    utils::sfread(FLERR,&cutoff_global,sizeof(double),1,fp,nullptr,error);
+  MPI_Bcast(&cutoff_global,1,MPI_DOUBLE,0,world);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void PairGranular::reset_dt()
@@ -40,6 +40,8 @@ class PairGranular : public Pair {
   double init_one(int, int) override;
   void write_restart(FILE *) override;
   void read_restart(FILE *) override;
+  void write_restart_settings(FILE *) override;
+  void read_restart_settings(FILE *) override;
   void reset_dt() override;
   double single(int, int, int, int, double, double, double, double &) override;
   int pack_forward_comm(int, int *, double *, int, int *) override;
@@ -70,7 +72,6 @@ class PairGranular : public Pair {
   void transfer_history(double *, double *, int, int) override;
   void prune_models();
 
- private:
   int size_history;
   int heat_flag;
 
@@ -44,6 +44,8 @@ using namespace LAMMPS_NS;
 PairEAMIntel::PairEAMIntel(LAMMPS *lmp) : PairEAM(lmp)
 {
   suffix_flag |= Suffix::INTEL;
+  overlap_enable = 0;
+  full_enable = 0;
   fp_float = nullptr;
 }
 
@@ -54,6 +54,11 @@ class CommKokkos : public CommBrick {
   void forward_comm(class Dump *) override;    // forward comm from a Dump
   void reverse_comm(class Dump *) override;    // reverse comm from a Dump
 
+  // batched clients use the per-client Kokkos-aware comms
+
+  void forward_comm_batch() override { Comm::forward_comm_batch(); }
+  void reverse_comm_batch() override { Comm::reverse_comm_batch(); }
+
   void forward_comm_array(int, double **) override;            // forward comm of array
 
   template<class DeviceType> void forward_comm_device(int dummy);
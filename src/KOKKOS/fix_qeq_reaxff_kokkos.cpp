@@ -58,6 +58,12 @@ FixQEqReaxFFKokkos(LAMMPS *lmp, int narg, char **arg) :
 {
   kokkosable = 1;
   comm_forward = comm_reverse = 2; // fused
+
+  // the s and t systems are always solved together here
+
+  if (dual_enabled)
+    error->all(FLERR,"Dual keyword is not supported by fix {}", style);
+
   forward_comm_device = exchange_comm_device = sort_device = 1;
   atomKK = (AtomKokkos *) atom;
   execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
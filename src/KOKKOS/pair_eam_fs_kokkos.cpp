@@ -44,6 +44,8 @@ template<class DeviceType>
 PairEAMFSKokkos<DeviceType>::PairEAMFSKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
+  full_enable = 0;
   single_enable = 0;
   one_coeff = 1;
   manybody_flag = 1;
@@ -41,6 +41,8 @@ template<class DeviceType>
 PairEAMKokkos<DeviceType>::PairEAMKokkos(LAMMPS *lmp) : PairEAM(lmp)
 {
   respa_enable = 0;
+  overlap_enable = 0;
+  full_enable = 0;
   single_enable = 0;
 
   kokkosable = 1;
@@ -28,14 +28,19 @@
 #include "Lepton.h"
 #include "lepton_utils.h"
 #include <cmath>
+#include <cstring>
 #include <map>
 
 using namespace LAMMPS_NS;
 
+static constexpr int MINTAB = 128;
+static constexpr int MAXTAB = 1 << 18;
+
 /* ---------------------------------------------------------------------- */
 
 PairLepton::PairLepton(LAMMPS *lmp) :
-    Pair(lmp), cut(nullptr), type2expression(nullptr), offset(nullptr)
+    Pair(lmp), cut(nullptr), type2expression(nullptr), offset(nullptr), ntables(0),
+    tables(nullptr), type2table(nullptr)
 {
   respa_enable = 0;
   single_enable = 1;
@@ -43,6 +48,9 @@ PairLepton::PairLepton(LAMMPS *lmp) :
   restartinfo = 1;
   reinitflag = 0;
   cut_global = 0.0;
+  tableflag = 0;
+  table_tol = 1.0e-6;
+  table_inner = 0.0;
   centroidstressflag = CENTROID_SAME;
 
   functions["zbl"] = new Lepton::ZBLFunction(force->qqr2e, force->angstrom, force->qelectron);
@@ -53,12 +61,14 @@ PairLepton::PairLepton(LAMMPS *lmp) :
 PairLepton::~PairLepton()
 {
   for (auto &f : functions) delete f.second;
+  free_tables();
   if (allocated) {
     memory->destroy(cut);
     memory->destroy(cutsq);
     memory->destroy(setflag);
     memory->destroy(type2expression);
     memory->destroy(offset);
+    memory->destroy(type2table);
   }
 }
 
@@ -103,6 +113,8 @@ template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairLepton::eval()
   const int *const *const firstneigh = list->firstneigh;
   double fxtmp, fytmp, fztmp;
 
+  // compile expressions, with tables they are only used below the inner cutoff
+
   std::vector<Lepton::CompiledExpression> pairforce;
   std::vector<Lepton::CompiledExpression> pairpot;
   try {
@@ -141,10 +153,24 @@ template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairLepton::eval()
 
       if (rsq < cutsq[itype][jtype]) {
         const double r = sqrt(rsq);
-        const int idx = type2expression[itype][jtype];
-        double &r_for = pairforce[idx].getVariableReference("r");
-        r_for = r;
-        const double fpair = -pairforce[idx].evaluate() / r * factor_lj;
+        double fpair;
+        double evdwl = 0.0;
+
+        if (tableflag && (r >= tables[type2table[itype][jtype]].rinner)) {
+          double dedr;
+          const double e = table_lookup(tables[type2table[itype][jtype]], r, dedr);
+          fpair = -dedr / r * factor_lj;
+          if (EFLAG) evdwl = (e - offset[itype][jtype]) * factor_lj;
+        } else {
+          const int idx = type2expression[itype][jtype];
+          pairforce[idx].getVariableReference("r") = r;
+          fpair = -pairforce[idx].evaluate() / r * factor_lj;
+          if (EFLAG) {
+            pairpot[idx].getVariableReference("r") = r;
+            evdwl = pairpot[idx].evaluate() - offset[itype][jtype];
+            evdwl *= factor_lj;
+          }
+        }
 
         fxtmp += delx * fpair;
         fytmp += dely * fpair;
@@ -155,13 +181,6 @@ template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void PairLepton::eval()
           f[j][2] -= delz * fpair;
         }
 
-        double evdwl = 0.0;
-        if (EFLAG) {
-          pairpot[idx].getVariableReference("r") = r;
-          evdwl = pairpot[idx].evaluate() - offset[itype][jtype];
-          evdwl *= factor_lj;
-        }
-
         if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz);
       }
     }
@@ -188,6 +207,7 @@ void PairLepton::allocate()
   memory->create(cutsq, np1, np1, "pair:cutsq");
   memory->create(type2expression, np1, np1, "pair:type2expression");
   memory->create(offset, np1, np1, "pair:offset");
+  memory->create(type2table, np1, np1, "pair:type2table");
 }
 
 /* ----------------------------------------------------------------------
@@ -196,8 +216,34 @@ void PairLepton::allocate()
 
 void PairLepton::settings(int narg, char **arg)
 {
-  if (narg != 1) error->all(FLERR, "Incorrect number of arguments for pair_style lepton command");
+  if (narg < 1) error->all(FLERR, "Incorrect number of arguments for pair_style lepton command");
   cut_global = utils::numeric(FLERR, arg[0], false, lmp);
+
+  tableflag = 0;
+  table_tol = 1.0e-6;
+  table_inner = 0.0;
+
+  int iarg = 1;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "table") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "pair_style lepton table", error);
+      if (strcmp(arg[iarg + 1], "no") == 0) {
+        tableflag = 0;
+      } else {
+        tableflag = 1;
+        table_tol = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+        if (table_tol <= 0.0)
+          error->all(FLERR, "Pair style lepton table tolerance must be > 0.0");
+      }
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "inner") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "pair_style lepton inner", error);
+      table_inner = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      if (table_inner <= 0.0) error->all(FLERR, "Pair style lepton inner cutoff must be > 0.0");
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown pair_style lepton keyword: {}", arg[iarg]);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -259,6 +305,24 @@ void PairLepton::coeff(int narg, char **arg)
   if (count == 0) error->all(FLERR, "Incorrect args for pair coefficients");
 }
 
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLepton::init_style()
+{
+  // tables are rebuilt from the current expressions and cutoffs here,
+  // so that errors in the expressions are reported before any compute()
+
+  free_tables();
+  if (tableflag) {
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++)
+        if (setflag[i][j]) type2table[i][j] = build_table(type2expression[i][j], cut[i][j]);
+  }
+  Pair::init_style();
+}
+
 /* ---------------------------------------------------------------------- */
 
 double PairLepton::init_one(int i, int j)
@@ -278,11 +342,133 @@ double PairLepton::init_one(int i, int j)
 
   cut[j][i] = cut[i][j];
   type2expression[j][i] = type2expression[i][j];
+  type2table[j][i] = type2table[i][j];
   offset[j][i] = offset[i][j];
 
   return cut[i][j];
 }
 
+/* ----------------------------------------------------------------------
+   tabulate expression from the inner cutoff to cut_one with cubic Hermite
+   splines using the exact first and second derivatives at the knots.
+   the number of intervals is doubled until the error at all interval
+   midpoints is below the tolerance relative to the local magnitude of
+   E and dE/dr. tables with the same expression and cutoff are shared.
+------------------------------------------------------------------------- */
+
+int PairLepton::build_table(int expr, double cut_one)
+{
+  for (int m = 0; m < ntables; ++m)
+    if ((tables[m].expr == expr) && (tables[m].cut == cut_one)) return m;
+
+  const double rinner = (table_inner > 0.0) ? table_inner : 0.2 * cut_one;
+  if (rinner >= cut_one)
+    error->all(FLERR, "Pair style lepton inner cutoff {} must be smaller than cutoff {}", rinner,
+               cut_one);
+
+  std::vector<Lepton::CompiledExpression> funcs;
+  try {
+    auto parsed = Lepton::Parser::parse(LeptonUtils::substitute(expressions[expr], lmp), functions);
+    auto deriv = parsed.differentiate("r");
+    funcs.emplace_back(parsed.createCompiledExpression());
+    funcs.emplace_back(deriv.createCompiledExpression());
+    funcs.emplace_back(deriv.differentiate("r").createCompiledExpression());
+  } catch (std::exception &e) {
+    error->all(FLERR, e.what());
+  }
+
+  // derivatives of simple expressions may not depend on r anymore
+
+  double rdummy;
+  double *rptr[3];
+  for (int k = 0; k < 3; ++k)
+    rptr[k] = funcs[k].getVariables().count("r") ? &funcs[k].getVariableReference("r") : &rdummy;
+
+  auto evaluate = [&](int k, double r) {
+    *rptr[k] = r;
+    return funcs[k].evaluate();
+  };
+
+  std::vector<double> e, de, d2e;
+  int ntab = MINTAB;
+  double delta, maxerr;
+  while (true) {
+    delta = (cut_one - rinner) / ntab;
+    e.resize(ntab + 1);
+    de.resize(ntab + 1);
+    d2e.resize(ntab + 1);
+    for (int k = 0; k <= ntab; ++k) {
+      const double r = rinner + k * delta;
+      e[k] = evaluate(0, r);
+      de[k] = evaluate(1, r);
+      d2e[k] = evaluate(2, r);
+      if (!std::isfinite(e[k]) || !std::isfinite(de[k]) || !std::isfinite(d2e[k]))
+        error->all(FLERR,
+                   "Pair style lepton expression {} is not finite at r = {} and cannot be "
+                   "tabulated. Increase the inner cutoff",
+                   expressions[expr], r);
+    }
+
+    // compare spline and exact values at interval midpoints
+
+    maxerr = 0.0;
+    for (int k = 0; k < ntab; ++k) {
+      const double r = rinner + (k + 0.5) * delta;
+      const double e_mid = evaluate(0, r);
+      const double de_mid = evaluate(1, r);
+      const double e_spl = 0.5 * (e[k] + e[k + 1]) + 0.125 * delta * (de[k] - de[k + 1]);
+      const double de_spl = 0.5 * (de[k] + de[k + 1]) + 0.125 * delta * (d2e[k] - d2e[k + 1]);
+      double scale = MAX(fabs(e_mid), MAX(fabs(e[k]), fabs(e[k + 1])));
+      if (scale > 0.0) maxerr = MAX(maxerr, fabs(e_spl - e_mid) / scale);
+      scale = MAX(fabs(de_mid), MAX(fabs(de[k]), fabs(de[k + 1])));
+      if (scale > 0.0) maxerr = MAX(maxerr, fabs(de_spl - de_mid) / scale);
+    }
+    if ((maxerr <= table_tol) || (ntab >= MAXTAB)) break;
+    ntab *= 2;
+  }
+
+  if ((maxerr > table_tol) && (comm->me == 0))
+    error->warning(FLERR,
+                   "Pair style lepton table for expression {} has a relative error of {:.8} "
+                   "with {} points which is larger than the requested tolerance {:.8}",
+                   expressions[expr], maxerr, ntab + 1, table_tol);
+
+  tables = (Table *) memory->srealloc(tables, (ntables + 1) * sizeof(Table), "pair:tables");
+  Table &tb = tables[ntables];
+  tb.expr = expr;
+  tb.ntab = ntab;
+  tb.cut = cut_one;
+  tb.rinner = rinner;
+  tb.invdelta = 1.0 / delta;
+  memory->create(tb.coeff, 8 * ntab, "pair:tablecoeff");
+
+  // polynomial coefficients in t = (r - r_k)/delta for E and dE/dr
+
+  for (int k = 0; k < ntab; ++k) {
+    double *c = tb.coeff + 8 * k;
+    c[0] = e[k];
+    c[1] = delta * de[k];
+    c[2] = 3.0 * (e[k + 1] - e[k]) - delta * (2.0 * de[k] + de[k + 1]);
+    c[3] = 2.0 * (e[k] - e[k + 1]) + delta * (de[k] + de[k + 1]);
+    c[4] = de[k];
+    c[5] = delta * d2e[k];
+    c[6] = 3.0 * (de[k + 1] - de[k]) - delta * (2.0 * d2e[k] + d2e[k + 1]);
+    c[7] = 2.0 * (de[k] - de[k + 1]) + delta * (d2e[k] + d2e[k + 1]);
+  }
+
+  return ntables++;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLepton::free_tables()
+{
+  for (int m = 0; m < ntables; ++m) memory->destroy(tables[m].coeff);
+  memory->sfree(tables);
+  tables = nullptr;
+  ntables = 0;
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes to restart file
 ------------------------------------------------------------------------- */
@@ -370,6 +556,9 @@ void PairLepton::write_restart_settings(FILE *fp)
 {
   fwrite(&cut_global, sizeof(double), 1, fp);
   fwrite(&offset_flag, sizeof(int), 1, fp);
+  fwrite(&tableflag, sizeof(int), 1, fp);
+  fwrite(&table_tol, sizeof(double), 1, fp);
+  fwrite(&table_inner, sizeof(double), 1, fp);
 }
 
 /* ----------------------------------------------------------------------
@@ -381,9 +570,15 @@ void PairLepton::read_restart_settings(FILE *fp)
   if (comm->me == 0) {
     utils::sfread(FLERR, &cut_global, sizeof(double), 1, fp, nullptr, error);
     utils::sfread(FLERR, &offset_flag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &tableflag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &table_tol, sizeof(double), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &table_inner, sizeof(double), 1, fp, nullptr, error);
   }
   MPI_Bcast(&cut_global, 1, MPI_DOUBLE, 0, world);
   MPI_Bcast(&offset_flag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&tableflag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&table_tol, 1, MPI_DOUBLE, 0, world);
+  MPI_Bcast(&table_inner, 1, MPI_DOUBLE, 0, world);
 }
 
 /* ----------------------------------------------------------------------
@@ -423,15 +618,31 @@ void PairLepton::write_data_all(FILE *fp)
 double PairLepton::single(int /* i */, int /* j */, int itype, int jtype, double rsq,
                           double /* factor_coul */, double factor_lj, double &fforce)
 {
+  const double r = sqrt(rsq);
+  if (tableflag && (r >= tables[type2table[itype][jtype]].rinner)) {
+    double dedr;
+    const double e = table_lookup(tables[type2table[itype][jtype]], r, dedr);
+    fforce = -dedr / r * factor_lj;
+    return (e - offset[itype][jtype]) * factor_lj;
+  }
+
   auto expr = expressions[type2expression[itype][jtype]];
   auto parsed = Lepton::Parser::parse(LeptonUtils::substitute(expr, lmp), functions);
   auto pairpot = parsed.createCompiledExpression();
   auto pairforce = parsed.differentiate("r").createCompiledExpression();
 
-  const double r = sqrt(rsq);
   pairpot.getVariableReference("r") = r;
   pairforce.getVariableReference("r") = r;
 
   fforce = -pairforce.evaluate() / r * factor_lj;
   return (pairpot.evaluate() - offset[itype][jtype]) * factor_lj;
 }
+
+/* ---------------------------------------------------------------------- */
+
+double PairLepton::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  for (int m = 0; m < ntables; ++m) bytes += (double) 8 * tables[m].ntab * sizeof(double);
+  return bytes;
+}
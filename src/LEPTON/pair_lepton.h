@@ -37,6 +37,7 @@ class PairLepton : public Pair {
   void compute(int, int) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
+  void init_style() override;
   double init_one(int, int) override;
   void write_restart(FILE *) override;
   void read_restart(FILE *) override;
@@ -45,6 +46,7 @@ class PairLepton : public Pair {
   void write_data(FILE *) override;
   void write_data_all(FILE *) override;
   double single(int, int, int, int, double, double, double, double &) override;
+  double memory_usage() override;
 
  protected:
   std::vector<std::string> expressions;
@@ -55,7 +57,36 @@ class PairLepton : public Pair {
   double **offset;
   double cut_global;
 
+  // optional tabulation of the potential and its derivative with cubic Hermite
+  // splines in r; each interval stores 4 coefficients for E and 4 for dE/dr
+
+  struct Table {
+    int expr, ntab;
+    double cut, rinner, invdelta;
+    double *coeff;
+  };
+  int tableflag;
+  double table_tol, table_inner;
+  int ntables;
+  Table *tables;
+  int **type2table;
+
   virtual void allocate();
+  void free_tables();
+  int build_table(int, double);
+
+  // return E(r) and set dE/dr from table, r must be within [rinner, cut]
+
+  static inline double table_lookup(const Table &tb, double r, double &dedr)
+  {
+    double s = (r - tb.rinner) * tb.invdelta;
+    int k = static_cast<int>(s);
+    if (k >= tb.ntab) k = tb.ntab - 1;
+    const double t = s - k;
+    const double *c = tb.coeff + 8 * k;
+    dedr = ((c[7] * t + c[6]) * t + c[5]) * t + c[4];
+    return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+  }
 
  private:
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval();
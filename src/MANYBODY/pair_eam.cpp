@@ -50,6 +50,13 @@ PairEAM::PairEAM(LAMMPS *lmp) : Pair(lmp)
   numforce = nullptr;
   type2frho = nullptr;
 
+  overlap_enable = 1;
+
+  fullflag = 0;
+  full_enable = 1;
+  fullpair = nullptr;
+  maxfullpair = 0;
+
   nfuncfl = 0;
   funcfl = nullptr;
 
@@ -84,6 +91,7 @@ PairEAM::~PairEAM()
   memory->destroy(rho);
   memory->destroy(fp);
   memory->destroy(numforce);
+  memory->destroy(fullpair);
 
   if (allocated) {
     memory->destroy(setflag);
@@ -141,18 +149,56 @@ PairEAM::~PairEAM()
 
 void PairEAM::compute(int eflag, int vflag)
 {
-  int i,j,ii,jj,m,inum,jnum,itype,jtype;
-  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
-  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
-  double *coeff;
-  int *ilist,*jlist,*numneigh,**firstneigh;
+  ev_init(eflag,vflag);
+  grow_peratom();
 
-  evdwl = 0.0;
+  if (fullflag) {
+    compute_full(eflag);
+    return;
+  }
+
+  zero_rho();
+  compute_rho(list->ilist,list->inum);
+  compute_embed_force(eflag);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   accumulate density of atoms with only owned neighbors
+   ghost atom coords may not yet be current
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_interior(int eflag, int vflag)
+{
   ev_init(eflag,vflag);
+  grow_peratom();
+
+  overlap_split(list);
+  zero_rho();
+  compute_rho(ilist_overlap,ninterior);
+}
+
+/* ----------------------------------------------------------------------
+   accumulate density of remaining atoms after ghost atom coords are
+     current, then complete the embedding and force computation
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_boundary(int eflag, int /*vflag*/)
+{
+  compute_rho(ilist_overlap+ninterior,nboundary);
+  compute_embed_force(eflag);
 
-  // grow energy and fp arrays if necessary
-  // need to be atom->nmax in length
+  if (vflag_fdotr) virial_fdotr_compute();
+}
 
+/* ----------------------------------------------------------------------
+   grow rho, fp, and numforce arrays if necessary
+   need to be atom->nmax in length
+------------------------------------------------------------------------- */
+
+void PairEAM::grow_peratom()
+{
   if (atom->nmax > nmax) {
     memory->destroy(rho);
     memory->destroy(fp);
@@ -162,25 +208,41 @@ void PairEAM::compute(int eflag, int vflag)
     memory->create(fp,nmax,"pair:fp");
     memory->create(numforce,nmax,"pair:numforce");
   }
+}
+
+/* ----------------------------------------------------------------------
+   zero out density
+------------------------------------------------------------------------- */
+
+void PairEAM::zero_rho()
+{
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+
+  if (force->newton_pair) {
+    for (int i = 0; i < nall; i++) rho[i] = 0.0;
+  } else for (int i = 0; i < nlocal; i++) rho[i] = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   accumulate density contributions for the inum atoms in ilist
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_rho(int *ilist, int inum)
+{
+  int i,j,ii,jj,m,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,rsq,p;
+  double *coeff;
+  int *jlist,*numneigh,**firstneigh;
 
   double **x = atom->x;
-  double **f = atom->f;
   int *type = atom->type;
   int nlocal = atom->nlocal;
-  int nall = nlocal + atom->nghost;
   int newton_pair = force->newton_pair;
 
-  inum = list->inum;
-  ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
-  // zero out density
-
-  if (newton_pair) {
-    for (i = 0; i < nall; i++) rho[i] = 0.0;
-  } else for (i = 0; i < nlocal; i++) rho[i] = 0.0;
-
   // rho = density at each atom
   // loop over neighbors of my atoms
 
@@ -218,6 +280,32 @@ void PairEAM::compute(int eflag, int vflag)
       }
     }
   }
+}
+
+/* ----------------------------------------------------------------------
+   complete density, then compute embedding energy and forces
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_embed_force(int eflag)
+{
+  int i,j,ii,jj,m,inum,jnum,itype,jtype;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
+  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
+  double *coeff;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
 
   // communicate and sum densities
 
@@ -323,8 +411,162 @@ void PairEAM::compute(int eflag, int vflag)
       }
     }
   }
+}
 
-  if (vflag_fdotr) virial_fdotr_compute();
+/* ----------------------------------------------------------------------
+   compute with a full neighbor list
+   rho of owned atoms is complete after the first pass, so only fp needs
+   to be communicated. distances and spline indices of all pairs within
+   the cutoff are stored in the first pass and reused in the second pass,
+   where forces are only applied to owned atoms.
+------------------------------------------------------------------------- */
+
+void PairEAM::compute_full(int eflag)
+{
+  int i,j,ii,jj,m,n,inum,jnum,itype,jtype,npair;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair,fxtmp,fytmp,fztmp;
+  double rsq,r,p,rhotmp,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
+  double *coeff;
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // grow per-pair storage if necessary
+
+  npair = 0;
+  for (ii = 0; ii < inum; ii++) npair += numneigh[ilist[ii]];
+  if (npair > maxfullpair) {
+    memory->destroy(fullpair);
+    maxfullpair = npair;
+    memory->create(fullpair,maxfullpair,"pair:fullpair");
+  }
+
+  // rho = density at each owned atom
+  // loop over all neighbors of my atoms
+
+  n = 0;
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    rhotmp = 0.0;
+    numforce[i] = 0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cutforcesq) {
+        jtype = type[j];
+        r = sqrt(rsq);
+        p = r*rdr + 1.0;
+        m = static_cast<int> (p);
+        m = MIN(m,nr-1);
+        p -= m;
+        p = MIN(p,1.0);
+        coeff = rhor_spline[type2rhor[jtype][itype]][m];
+        rhotmp += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+        FullPair &pair = fullpair[n++];
+        pair.delx = delx;
+        pair.dely = dely;
+        pair.delz = delz;
+        pair.recip = 1.0/r;
+        pair.p = p;
+        pair.j = j;
+        pair.m = m;
+        ++numforce[i];
+      }
+    }
+    rho[i] = rhotmp;
+  }
+
+  // fp = derivative of embedding energy at each atom
+  // phi = embedding energy at each atom
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    p = rho[i]*rdrho + 1.0;
+    m = static_cast<int> (p);
+    m = MAX(1,MIN(m,nrho-1));
+    p -= m;
+    p = MIN(p,1.0);
+    coeff = frho_spline[type2frho[type[i]]][m];
+    fp[i] = (coeff[0]*p + coeff[1])*p + coeff[2];
+    if (eflag) {
+      phi = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+      if (rho[i] > rhomax) phi += fp[i] * (rho[i]-rhomax);
+      phi *= scale[type[i]][type[i]];
+      if (eflag_global) eng_vdwl += phi;
+      if (eflag_atom) eatom[i] += phi;
+    }
+  }
+
+  // communicate derivative of embedding function
+
+  comm->forward_comm(this);
+  embedstep = update->ntimestep;
+
+  // compute forces on owned atoms from stored pairs
+  // each pair is visited twice, so energy and virial are tallied by halves
+
+  n = 0;
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    itype = type[i];
+    jnum = numforce[i];
+    fxtmp = fytmp = fztmp = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      const FullPair &pair = fullpair[n++];
+      j = pair.j;
+      jtype = type[j];
+      m = pair.m;
+      p = pair.p;
+      recip = pair.recip;
+
+      coeff = rhor_spline[type2rhor[itype][jtype]][m];
+      rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = rhor_spline[type2rhor[jtype][itype]][m];
+      rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
+      coeff = z2r_spline[type2z2r[itype][jtype]][m];
+      z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
+      z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+
+      phi = z2*recip;
+      phip = z2p*recip - phi*recip;
+      psip = fp[i]*rhojp + fp[j]*rhoip + phip;
+      fpair = -scale[itype][jtype]*psip*recip;
+
+      fxtmp += pair.delx*fpair;
+      fytmp += pair.dely*fpair;
+      fztmp += pair.delz*fpair;
+
+      if (eflag) evdwl = scale[itype][jtype]*phi;
+      if (evflag) ev_tally_full(i,evdwl,0.0,fpair,pair.delx,pair.dely,pair.delz);
+    }
+    f[i][0] += fxtmp;
+    f[i][1] += fytmp;
+    f[i][2] += fztmp;
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -357,9 +599,26 @@ void PairEAM::allocate()
    global settings
 ------------------------------------------------------------------------- */
 
-void PairEAM::settings(int narg, char **/*arg*/)
+void PairEAM::settings(int narg, char **arg)
 {
-  if (narg > 0) error->all(FLERR,"Illegal pair_style command");
+  fullflag = 0;
+  if (narg > 1) error->all(FLERR,"Illegal pair_style command");
+  if (narg == 1) {
+    if (strcmp(arg[0],"full") == 0) fullflag = 1;
+    else error->all(FLERR,"Unknown pair_style eam keyword: {}", arg[0]);
+  }
+
+  // accelerated variants and derived styles have their own compute()
+  //   that only works with a half neighbor list and clear full_enable
+
+  if (fullflag && !full_enable)
+    error->all(FLERR,"This pair style eam variant does not support the full keyword");
+
+  // forces are not applied to ghost atoms, so virial must be tallied per pair
+  // the density pass with a full list cannot be split for comm overlap
+
+  no_virial_fdotr_compute = fullflag;
+  if (fullflag) overlap_enable = 0;
 }
 
 /* ----------------------------------------------------------------------
@@ -424,7 +683,8 @@ void PairEAM::init_style()
   file2array();
   array2spline();
 
-  neighbor->add_request(this);
+  if (fullflag) neighbor->add_request(this, NeighConst::REQ_FULL);
+  else neighbor->add_request(this);
   embedstep = -1;
 }
 
@@ -909,6 +1169,7 @@ double PairEAM::memory_usage()
   double bytes = (double)maxeatom * sizeof(double);
   bytes += (double)maxvatom*6 * sizeof(double);
   bytes += (double)2 * nmax * sizeof(double);
+  bytes += (double)maxfullpair * sizeof(FullPair);
   return bytes;
 }
 
@@ -47,6 +47,8 @@ class PairEAM : public Pair {
   PairEAM(class LAMMPS *);
   ~PairEAM() override;
   void compute(int, int) override;
+  void compute_interior(int, int) override;
+  void compute_boundary(int, int) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
   void init_style() override;
@@ -68,6 +70,19 @@ class PairEAM : public Pair {
   double **scale;
   bigint embedstep;    // timestep, the embedding term was computed
 
+  // optional evaluation with a full neighbor list, which avoids the
+  // reverse communication of rho and caches per-pair data between passes
+
+  int fullflag;       // 1 if full neighbor list is used
+  int full_enable;    // 1 if style supports the full keyword
+
+  struct FullPair {
+    double delx, dely, delz, recip, p;
+    int j, m;
+  };
+  FullPair *fullpair;
+  int maxfullpair;
+
   // per-atom arrays
 
   double *rho, *fp;
@@ -102,6 +117,12 @@ class PairEAM : public Pair {
   };
   Fs *fs;
 
+  void compute_full(int);
+  void grow_peratom();
+  void zero_rho();
+  void compute_rho(int *, int);
+  void compute_embed_force(int);
+
   virtual void allocate();
   virtual void array2spline();
   void interpolate(int, double, double *, double **);
@@ -39,6 +39,8 @@ PairEAMCD::PairEAMCD(LAMMPS *lmp, int _cdeamVersion)
 {
   single_enable = 0;
   restartinfo = 0;
+  full_enable = 0;
+  overlap_enable = 0;
   unit_convert_flag = utils::get_supported_conversions(utils::ENERGY);
 
   rhoB = nullptr;
@@ -33,6 +33,8 @@ using namespace LAMMPS_NS;
 PairEAMHE::PairEAMHE(LAMMPS *lmp) : PairEAM(lmp), PairEAMFS(lmp)
 {
   he_flag = 1;
+  full_enable = 0;
+  overlap_enable = 0;
 }
 
 void PairEAMHE::compute(int eflag, int vflag)
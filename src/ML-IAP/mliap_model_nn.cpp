@@ -30,6 +30,8 @@ using namespace LAMMPS_NS;
 
 #define MAXLINE 1024
 
+static constexpr int NBATCH = 64;    // max number of atoms processed together
+
 /* ---------------------------------------------------------------------- */
 
 MLIAPModelNN::MLIAPModelNN(LAMMPS *_lmp, char *coefffilename) : MLIAPModel(_lmp, coefffilename)
@@ -37,6 +39,10 @@ MLIAPModelNN::MLIAPModelNN(LAMMPS *_lmp, char *coefffilename) : MLIAPModel(_lmp,
   nnodes = nullptr;
   activation = nullptr;
   scale = nullptr;
+  maxnodes = 0;
+  batch = nullptr;
+  xin = nullptr;
+  nodes = dnodes = bnodes = nullptr;
   if (coefffilename) MLIAPModelNN::read_coeffs(coefffilename);
   nonlinearflag = 1;
 }
@@ -48,6 +54,11 @@ MLIAPModelNN::~MLIAPModelNN()
   memory->destroy(nnodes);
   memory->destroy(activation);
   memory->destroy(scale);
+  memory->destroy(batch);
+  memory->destroy(xin);
+  memory->destroy(nodes);
+  memory->destroy(dnodes);
+  memory->destroy(bnodes);
 }
 
 /* ----------------------------------------------------------------------
@@ -215,132 +226,172 @@ void MLIAPModelNN::read_coeffs(char *coefffilename)
 /*  ----------------------------------------------------------------------
    Calculate model gradients w.r.t descriptors
    for each atom beta_i = dE(B_i)/dB_i
+   atoms of the same element are processed in batches of up to NBATCH,
+   so that the weights of each layer are reused for all atoms in the batch
    ---------------------------------------------------------------------- */
 
 void MLIAPModelNN::compute_gradients(MLIAPData *data)
 {
   data->energy = 0.0;
 
-  for (int ii = 0; ii < data->nlistatoms; ii++) {
-    const int ielem = data->ielems[ii];
-    const int nl = nlayers;
-
-    double *coeffi = coeffelem[ielem];
-    double **scalei = scale[ielem];
-    double **nodes, **dnodes, **bnodes;
-
-    nodes = new double *[nl];
-    dnodes = new double *[nl];
-    bnodes = new double *[nl];
-    for (int l = 0; l < nl; ++l) {
-      nodes[l] = new double[nnodes[l]];
-      dnodes[l] = new double[nnodes[l]];
-      bnodes[l] = new double[nnodes[l]];
-    }
-
-    // forwardprop
-    // input - hidden1
+  if (!nodes) allocate_workspace();
 
-    for (int n = 0; n < nnodes[0]; n++) {
-      nodes[0][n] = 0;
-      for (int icoeff = 0; icoeff < data->ndescriptors; icoeff++) {
-        nodes[0][n] += coeffi[n * ((data->ndescriptors) + 1) + icoeff + 1] *
-            (data->descriptors[ii][icoeff] - scalei[0][icoeff]) / scalei[1][icoeff];
-      }
-      if (activation[0] == 1) {
-        nodes[0][n] = sigm(nodes[0][n] + coeffi[n * ((data->ndescriptors) + 1)], dnodes[0][n]);
-      } else if (activation[0] == 2) {
-        nodes[0][n] = tanh(nodes[0][n] + coeffi[n * ((data->ndescriptors) + 1)], dnodes[0][n]);
-      } else if (activation[0] == 3) {
-        nodes[0][n] = relu(nodes[0][n] + coeffi[n * ((data->ndescriptors) + 1)], dnodes[0][n]);
-      } else {
-        nodes[0][n] += coeffi[n * ((data->ndescriptors) + 1)];
-        dnodes[0][n] = 1;
+  for (int ielem = 0; ielem < nelements; ielem++) {
+    int nbatch = 0;
+    for (int ii = 0; ii < data->nlistatoms; ii++) {
+      if (data->ielems[ii] != ielem) continue;
+      batch[nbatch++] = ii;
+      if (nbatch == NBATCH) {
+        compute_batch(data, ielem, nbatch);
+        nbatch = 0;
       }
     }
+    if (nbatch) compute_batch(data, ielem, nbatch);
+  }
+}
+
+/*  ----------------------------------------------------------------------
+   forward and backward propagation for a batch of atoms of element ielem
+   layer values of atom a in batch are stored at nodes[l][a*nnodes[l]]
+   ---------------------------------------------------------------------- */
 
-    // hidden~output
-
-    int k = 0;
-    if (nl > 1) {
-      k += ((data->ndescriptors) + 1) * nnodes[0];
-      for (int l = 1; l < nl; l++) {
-        for (int n = 0; n < nnodes[l]; n++) {
-          nodes[l][n] = 0;
-          for (int j = 0; j < nnodes[l - 1]; j++) {
-            nodes[l][n] += coeffi[k + n * (nnodes[l - 1] + 1) + j + 1] * nodes[l - 1][j];
-          }
-          if (activation[l] == 1) {
-            nodes[l][n] = sigm(nodes[l][n] + coeffi[k + n * (nnodes[l - 1] + 1)], dnodes[l][n]);
-          } else if (activation[l] == 2) {
-            nodes[l][n] = tanh(nodes[l][n] + coeffi[k + n * (nnodes[l - 1] + 1)], dnodes[l][n]);
-          } else if (activation[l] == 3) {
-            nodes[l][n] = relu(nodes[l][n] + coeffi[k + n * (nnodes[l - 1] + 1)], dnodes[l][n]);
-          } else {
-            nodes[l][n] += coeffi[k + n * (nnodes[l - 1] + 1)];
-            dnodes[l][n] = 1;
-          }
+void MLIAPModelNN::compute_batch(MLIAPData *data, int ielem, int nbatch)
+{
+  const int nl = nlayers;
+  const int ndesc = data->ndescriptors;
+  const double *coeffi = coeffelem[ielem];
+  double **scalei = scale[ielem];
+
+  for (int a = 0; a < nbatch; a++) {
+    const double *desc = data->descriptors[batch[a]];
+    double *xa = &xin[a * ndesc];
+    for (int icoeff = 0; icoeff < ndesc; icoeff++) xa[icoeff] = desc[icoeff] - scalei[0][icoeff];
+  }
+
+  // forwardprop
+  // input - hidden1
+
+  for (int n = 0; n < nnodes[0]; n++) {
+    const double *w = &coeffi[n * (ndesc + 1)];
+    for (int a = 0; a < nbatch; a++) {
+      const double *xa = &xin[a * ndesc];
+      double sum = 0.0;
+      for (int icoeff = 0; icoeff < ndesc; icoeff++)
+        sum += w[icoeff + 1] * xa[icoeff] / scalei[1][icoeff];
+      nodes[0][a * nnodes[0] + n] = sum + w[0];
+    }
+  }
+  activate(activation[0], nbatch * nnodes[0], nodes[0], dnodes[0]);
+
+  // hidden~output
+
+  int k = 0;
+  if (nl > 1) {
+    k += (ndesc + 1) * nnodes[0];
+    for (int l = 1; l < nl; l++) {
+      const int nprev = nnodes[l - 1];
+      for (int n = 0; n < nnodes[l]; n++) {
+        const double *w = &coeffi[k + n * (nprev + 1)];
+        for (int a = 0; a < nbatch; a++) {
+          const double *prev = &nodes[l - 1][a * nprev];
+          double sum = 0.0;
+          for (int j = 0; j < nprev; j++) sum += w[j + 1] * prev[j];
+          nodes[l][a * nnodes[l] + n] = sum + w[0];
         }
-        k += (nnodes[l - 1] + 1) * nnodes[l];
       }
+      activate(activation[l], nbatch * nnodes[l], nodes[l], dnodes[l]);
+      k += (nprev + 1) * nnodes[l];
     }
+  }
 
-    // backwardprop
-    // output layer dnode initialized to 1.
+  // backwardprop
+  // output layer dnode initialized to 1.
 
-    for (int n = 0; n < nnodes[nl - 1]; n++) {
-      if (activation[nl - 1] == 0) {
-        bnodes[nl - 1][n] = 1;
-      } else {
-        bnodes[nl - 1][n] = dnodes[nl - 1][n];
-      }
-    }
+  for (int m = 0; m < nbatch * nnodes[nl - 1]; m++) {
+    if (activation[nl - 1] == 0)
+      bnodes[nl - 1][m] = 1;
+    else
+      bnodes[nl - 1][m] = dnodes[nl - 1][m];
+  }
 
-    if (nl > 1) {
-      for (int l = nl - 1; l > 0; l--) {
-        k -= (nnodes[l - 1] + 1) * nnodes[l];
-        for (int n = 0; n < nnodes[l - 1]; n++) {
-          bnodes[l - 1][n] = 0;
-          for (int j = 0; j < nnodes[l]; j++) {
-            bnodes[l - 1][n] += coeffi[k + j * (nnodes[l - 1] + 1) + n + 1] * bnodes[l][j];
-          }
-          if (activation[l - 1] >= 1) { bnodes[l - 1][n] *= dnodes[l - 1][n]; }
+  if (nl > 1) {
+    for (int l = nl - 1; l > 0; l--) {
+      const int nprev = nnodes[l - 1];
+      k -= (nprev + 1) * nnodes[l];
+      for (int a = 0; a < nbatch; a++) {
+        double *bprev = &bnodes[l - 1][a * nprev];
+        for (int n = 0; n < nprev; n++) bprev[n] = 0;
+      }
+      for (int j = 0; j < nnodes[l]; j++) {
+        const double *w = &coeffi[k + j * (nprev + 1) + 1];
+        for (int a = 0; a < nbatch; a++) {
+          const double bj = bnodes[l][a * nnodes[l] + j];
+          double *bprev = &bnodes[l - 1][a * nprev];
+          for (int n = 0; n < nprev; n++) bprev[n] += w[n] * bj;
         }
       }
+      if (activation[l - 1] >= 1)
+        for (int m = 0; m < nbatch * nprev; m++) bnodes[l - 1][m] *= dnodes[l - 1][m];
     }
+  }
 
-    for (int icoeff = 0; icoeff < data->ndescriptors; icoeff++) {
-      data->betas[ii][icoeff] = 0;
-      for (int j = 0; j < nnodes[0]; j++) {
-        data->betas[ii][icoeff] +=
-            coeffi[j * ((data->ndescriptors) + 1) + icoeff + 1] * bnodes[0][j];
-      }
-      data->betas[ii][icoeff] = data->betas[ii][icoeff] / scalei[1][icoeff];
+  for (int a = 0; a < nbatch; a++) {
+    const int ii = batch[a];
+    double *betai = data->betas[ii];
+    for (int icoeff = 0; icoeff < ndesc; icoeff++) betai[icoeff] = 0;
+    for (int j = 0; j < nnodes[0]; j++) {
+      const double *w = &coeffi[j * (ndesc + 1) + 1];
+      const double bj = bnodes[0][a * nnodes[0] + j];
+      for (int icoeff = 0; icoeff < ndesc; icoeff++) betai[icoeff] += w[icoeff] * bj;
     }
+    for (int icoeff = 0; icoeff < ndesc; icoeff++) betai[icoeff] /= scalei[1][icoeff];
 
     if (data->eflag) {
 
       // energy of atom I (E_i)
 
-      double etmp = nodes[nl - 1][0];
+      double etmp = nodes[nl - 1][a * nnodes[nl - 1]];
 
       data->energy += etmp;
       data->eatoms[ii] = etmp;
     }
-    // Deleting the variables
+  }
+}
 
-    for (int n = 0; n < nl; n++) {
-      delete[] nodes[n];
-      delete[] dnodes[n];
-      delete[] bnodes[n];
-    }
+/*  ----------------------------------------------------------------------
+   apply activation function to n node values after bias was added
+   store derivatives in dnode
+   ---------------------------------------------------------------------- */
 
-    delete[] nodes;
-    delete[] dnodes;
-    delete[] bnodes;
+void MLIAPModelNN::activate(int act, int n, double *node, double *dnode)
+{
+  if (act == 1) {
+    for (int m = 0; m < n; m++) node[m] = sigm(node[m], dnode[m]);
+  } else if (act == 2) {
+    for (int m = 0; m < n; m++) node[m] = tanh(node[m], dnode[m]);
+  } else if (act == 3) {
+    for (int m = 0; m < n; m++) node[m] = relu(node[m], dnode[m]);
+  } else {
+    for (int m = 0; m < n; m++) dnode[m] = 1;
   }
 }
 
+/*  ----------------------------------------------------------------------
+   allocate workspace for batches of atoms once layer sizes are known
+   ---------------------------------------------------------------------- */
+
+void MLIAPModelNN::allocate_workspace()
+{
+  maxnodes = 0;
+  for (int l = 0; l < nlayers; l++) maxnodes = MAX(maxnodes, nnodes[l]);
+
+  memory->create(batch, NBATCH, "mliap_model:batch");
+  memory->create(xin, NBATCH * ndescriptors, "mliap_model:xin");
+  memory->create(nodes, nlayers, NBATCH * maxnodes, "mliap_model:nodes");
+  memory->create(dnodes, nlayers, NBATCH * maxnodes, "mliap_model:dnodes");
+  memory->create(bnodes, nlayers, NBATCH * maxnodes, "mliap_model:bnodes");
+}
+
 /* ----------------------------------------------------------------------
    Calculate model double gradients w.r.t descriptors and parameters
    for each atom energy gamma_lk = d2E(B)/dB_k/dsigma_l,
@@ -389,5 +440,10 @@ double MLIAPModelNN::memory_usage()
   bytes += (double) nelements * 2 * ndescriptors * sizeof(double);    // scale
   bytes += (int) nlayers * sizeof(int);                               // nnodes
   bytes += (int) nlayers * sizeof(int);                               // activation
+  if (nodes) {
+    bytes += (double) NBATCH * sizeof(int);                              // batch
+    bytes += (double) NBATCH * ndescriptors * sizeof(double);            // xin
+    bytes += (double) 3 * nlayers * NBATCH * maxnodes * sizeof(double);  // nodes,dnodes,bnodes
+  }
   return bytes;
 }
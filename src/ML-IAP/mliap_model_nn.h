@@ -39,6 +39,19 @@ class MLIAPModelNN : public MLIAPModel {
   double ***scale;    // element scale values
   void read_coeffs(char *) override;
 
+  // persistent workspace for a batch of atoms of the same element
+
+  int maxnodes;       // max number of nodes in any layer
+  int *batch;         // list indices of atoms in batch
+  double *xin;        // shifted descriptors of atoms in batch
+  double **nodes;     // node values per layer and atom in batch
+  double **dnodes;    // node derivatives per layer and atom in batch
+  double **bnodes;    // backpropagated values per layer and atom in batch
+
+  void allocate_workspace();
+  void compute_batch(class MLIAPData *, int, int);
+  void activate(int, int, double *, double *);
+
   inline double sigm(double x, double &deriv)
   {
     double expl = 1. / (1. + exp(-x));
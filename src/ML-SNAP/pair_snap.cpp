@@ -113,6 +113,12 @@ void PairSNAP::compute(int eflag, int vflag)
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
+  // reuse neighbor geometry if shared with other pair hybrid sub-styles
+  // cached displacements are xi - xj, so flip their sign
+
+  int *geomoffset;
+  double **geom = geomhost ? geomhost->neigh_geometry(list, geomoffset) : nullptr;
+
   for (int ii = 0; ii < list->inum; ii++) {
     i = list->ilist[ii];
 
@@ -136,14 +142,23 @@ void PairSNAP::compute(int eflag, int vflag)
     // rcutij = cutoffs for neighbors of I within cutoff
     // note Rij sign convention => dU/dRij = dU/dRj = -dU/dRi
 
+    double **dr = geom ? geom + geomoffset[ii] : nullptr;
+
     ninside = 0;
     for (int jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
       j &= NEIGHMASK;
-      delx = x[j][0] - xtmp;
-      dely = x[j][1] - ytmp;
-      delz = x[j][2] - ztmp;
-      rsq = delx*delx + dely*dely + delz*delz;
+      if (dr) {
+        delx = -dr[jj][0];
+        dely = -dr[jj][1];
+        delz = -dr[jj][2];
+        rsq = dr[jj][3];
+      } else {
+        delx = x[j][0] - xtmp;
+        dely = x[j][1] - ytmp;
+        delz = x[j][2] - ztmp;
+        rsq = delx*delx + dely*dely + delz*delz;
+      }
       int jtype = type[j];
       int jelem = map[jtype];
 
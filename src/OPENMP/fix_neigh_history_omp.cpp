@@ -194,7 +194,9 @@ void FixNeighHistoryOMP::pre_exchange_newton()
 {
   const int nthreads = comm->nthreads;
   maxpartner = 0;
-  for (int i = 0; i < nall_neigh; i++) npartner[i] = 0;
+  const int nall = atom->nlocal + atom->nghost;
+  const int nzero = MAX(nall_neigh, nall);
+  for (int i = 0; i < nzero; i++) npartner[i] = 0;
 
 #if defined(_OPENMP)
 #pragma omp parallel LMP_DEFAULT_NONE
@@ -221,6 +223,7 @@ void FixNeighHistoryOMP::pre_exchange_newton()
     // calculate npartner for each owned+ghost atom
 
     tagint *tag = atom->tag;
+    int *type = atom->type;
 
     NeighList *list = pair->list;
     inum = list->inum;
@@ -229,10 +232,10 @@ void FixNeighHistoryOMP::pre_exchange_newton()
     firstneigh = list->firstneigh;
 
     // each thread works on a fixed chunk of local and ghost atoms.
-    const int ldelta = 1 + nlocal_neigh / nthreads;
+    const int ldelta = 1 + nall_neigh / nthreads;
     const int lfrom = tid * ldelta;
     const int lmax = lfrom + ldelta;
-    const int lto = (lmax > nlocal_neigh) ? nlocal_neigh : lmax;
+    const int lto = (lmax > nall_neigh) ? nall_neigh : lmax;
 
     for (ii = 0; ii < inum; ii++) {
       i = ilist[ii];
@@ -264,6 +267,12 @@ void FixNeighHistoryOMP::pre_exchange_newton()
       commflag = NPARTNER;
       comm->reverse_comm(this, 0);
     }
+#if defined(_OPENMP)
+#pragma omp barrier
+    {
+      ;
+    }
+#endif
 
     // get page chunks to store atom IDs and shear history for my atoms
 
@@ -278,18 +287,12 @@ void FixNeighHistoryOMP::pre_exchange_newton()
       }
     }
 
-#if defined(_OPENMP)
-#pragma omp master
-#endif
-    {
-      for (i = nlocal_neigh; i < nall_neigh; i++) {
-        n = npartner[i];
-        partner[i] = ipg.get(n);
-        valuepartner[i] = dpg.get(dnum * n);
-        if (partner[i] == nullptr || valuepartner[i] == nullptr) {
-          error->one(FLERR, "Neighbor history overflow, boost neigh_modify one");
-        }
-      }
+    for (i = MAX(lfrom, nlocal_neigh); i < lto; i++) {
+      n = npartner[i];
+      partner[i] = ipg.get(n);
+      valuepartner[i] = dpg.get(dnum * n);
+      if (partner[i] == nullptr || valuepartner[i] == nullptr)
+        error->one(FLERR, "Neighbor history overflow, boost neigh_modify one");
     }
 
     // 2nd loop over neighbor list
@@ -321,7 +324,10 @@ void FixNeighHistoryOMP::pre_exchange_newton()
             m = npartner[j]++;
             partner[j][m] = tag[i];
             jvalues = &valuepartner[j][dnum * m];
-            for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
+            if (pair->nondefault_history_transfer)
+              pair->transfer_history(onevalues, jvalues, type[i], type[j]);
+            else
+              for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
           }
         }
       }
@@ -343,11 +349,17 @@ void FixNeighHistoryOMP::pre_exchange_newton()
       commflag = PERPARTNER;
       comm->reverse_comm_variable(this);
     }
+#if defined(_OPENMP)
+#pragma omp barrier
+    {
+      ;
+    }
+#endif
 
     // set maxpartner = max # of partners of any owned atom
     // maxexchange = max # of values for any Comm::exchange() atom
     m = 0;
-    for (i = lfrom; i < lto; i++) m = MAX(m, npartner[i]);
+    for (i = lfrom; i < MIN(lto, nlocal_neigh); i++) m = MAX(m, npartner[i]);
 
 #if defined(_OPENMP)
 #pragma omp critical
@@ -396,6 +408,7 @@ void FixNeighHistoryOMP::pre_exchange_no_newton()
     // calculate npartner for each owned atom
 
     tagint *tag = atom->tag;
+    int *type = atom->type;
 
     NeighList *list = pair->list;
     inum = list->inum;
@@ -473,7 +486,10 @@ void FixNeighHistoryOMP::pre_exchange_no_newton()
             m = npartner[j]++;
             partner[j][m] = tag[i];
             jvalues = &valuepartner[j][dnum * m];
-            for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
+            if (pair->nondefault_history_transfer)
+              pair->transfer_history(onevalues, jvalues, type[i], type[j]);
+            else
+              for (n = 0; n < dnum; n++) jvalues[n] = -onevalues[n];
           }
         }
       }
@@ -567,13 +583,23 @@ void FixNeighHistoryOMP::post_neighbor()
 
       for (jj = 0; jj < jnum; jj++) {
         j = jlist[jj];
-        rflag = histmask(j);
+
+        if (use_bit_flag) {
+          rflag = histmask(j) | pair->beyond_contact;
+          j &= HISTMASK;
+          jlist[jj] = j;
+        } else {
+          rflag = 1;
+        }
+
+        // Remove special bond bits
         j &= NEIGHMASK;
-        jlist[jj] = j;
 
-        // rflag = 1 if r < radsum in npair_size() method
+        // rflag = 1 if r < radsum in npair_size() method or if pair interactions extend further
         // preserve neigh history info if tag[j] is in old-neigh partner list
         // this test could be more geometrically precise for two sphere/line/tri
+        // if use_bit_flag is turned off, always record data since not all npair classes
+        // apply a mask for history (and they could use the bits for special bonds)
 
         if (rflag) {
           jtag = tag[j];
@@ -27,6 +27,11 @@
 #include "omp_compat.h"
 using namespace LAMMPS_NS;
 
+// number of neighbors within the cutoff that are gathered and then
+// processed together in vectorizable loops
+
+static constexpr int NBLOCK = 32;
+
 /* ---------------------------------------------------------------------- */
 
 PairEAMOMP::PairEAMOMP(LAMMPS *lmp) :
@@ -34,6 +39,65 @@ PairEAMOMP::PairEAMOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  overlap_enable = 0;
+  full_enable = 0;
+
+  rhor_soa = z2r_soa = nullptr;
+  rhor_off = rhor_offT = z2r_off = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairEAMOMP::~PairEAMOMP()
+{
+  memory->destroy(rhor_soa);
+  memory->destroy(z2r_soa);
+  memory->destroy(rhor_off);
+  memory->destroy(rhor_offT);
+  memory->destroy(z2r_off);
+}
+
+/* ----------------------------------------------------------------------
+   in addition to the per-table splines, store the rhor and z2r spline
+   coefficients so that each coefficient of all tables is contiguous.
+   a neighbor of type J of an atom of type I then uses coefficient k at
+   soa[k][off[I][J] + m], which allows to evaluate neighbors of different
+   types in the same vector loop.
+------------------------------------------------------------------------- */
+
+void PairEAMOMP::array2spline()
+{
+  PairEAM::array2spline();
+
+  const int nr1 = nr + 1;
+  const int n = atom->ntypes;
+
+  memory->destroy(rhor_soa);
+  memory->destroy(z2r_soa);
+  memory->destroy(rhor_off);
+  memory->destroy(rhor_offT);
+  memory->destroy(z2r_off);
+
+  memory->create(rhor_soa,7,nrhor*nr1,"pair:rhor_soa");
+  memory->create(z2r_soa,7,nz2r*nr1,"pair:z2r_soa");
+  memory->create(rhor_off,n+1,n+1,"pair:rhor_off");
+  memory->create(rhor_offT,n+1,n+1,"pair:rhor_offT");
+  memory->create(z2r_off,n+1,n+1,"pair:z2r_off");
+
+  for (int k = 0; k < 7; k++) {
+    for (int t = 0; t < nrhor; t++)
+      for (int m = 0; m < nr1; m++) rhor_soa[k][t*nr1 + m] = rhor_spline[t][m][k];
+    for (int t = 0; t < nz2r; t++)
+      for (int m = 0; m < nr1; m++) z2r_soa[k][t*nr1 + m] = z2r_spline[t][m][k];
+  }
+
+  for (int i = 1; i <= n; i++) {
+    for (int j = 1; j <= n; j++) {
+      rhor_off[i][j] = type2rhor[i][j] * nr1;
+      rhor_offT[i][j] = type2rhor[j][i] * nr1;
+      z2r_off[i][j] = type2z2r[i][j] * nr1;
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -96,9 +160,9 @@ void PairEAMOMP::compute(int eflag, int vflag)
 template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
 void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
 {
-  int i,j,ii,jj,m,jnum,itype,jtype;
+  int i,j,ii,jj,m,jnum,itype;
   double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,fpair;
-  double rsq,r,p,rhoip,rhojp,z2,z2p,recip,phip,psip,phi;
+  double rsq,p,phi;
   double *coeff;
   int *ilist,*jlist,*numneigh,**firstneigh;
 
@@ -121,7 +185,17 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   firstneigh = list->firstneigh;
 
   // rho = density at each atom
-  // loop over neighbors of my atoms
+  // loop over neighbors of my atoms in blocks of up to NBLOCK neighbors
+  // within the cutoff: gather, evaluate splines vectorized, scatter
+
+  int jblk[NBLOCK], tblk[NBLOCK];
+  double rblk[NBLOCK], rhoblk[NBLOCK];
+  double delxblk[NBLOCK], delyblk[NBLOCK], delzblk[NBLOCK], fpairblk[NBLOCK], evdwlblk[NBLOCK];
+
+  const double * _noalias const rc3 = rhor_soa[3];
+  const double * _noalias const rc4 = rhor_soa[4];
+  const double * _noalias const rc5 = rhor_soa[5];
+  const double * _noalias const rc6 = rhor_soa[6];
 
   for (ii = iifrom; ii < iito; ii++) {
     i = ilist[ii];
@@ -131,31 +205,50 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
     itype = type[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
-
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
-
-      delx = xtmp - x[j].x;
-      dely = ytmp - x[j].y;
-      delz = ztmp - x[j].z;
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq < cutforcesq) {
-        jtype = type[j];
-        p = sqrt(rsq)*rdr + 1.0;
-        m = static_cast<int> (p);
-        m = MIN(m,nr-1);
-        p -= m;
-        p = MIN(p,1.0);
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rho_t[i] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
-        if (NEWTON_PAIR || j < nlocal) {
-          coeff = rhor_spline[type2rhor[itype][jtype]][m];
-          rho_t[j] += ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
+    const int * _noalias const offij = rhor_off[itype];
+    const int * _noalias const offji = rhor_offT[itype];
+    double rhoi = 0.0;
+
+    for (jj = 0; jj < jnum;) {
+      int nblk = 0;
+      for (; (jj < jnum) && (nblk < NBLOCK); ++jj) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+
+        delx = xtmp - x[j].x;
+        dely = ytmp - x[j].y;
+        delz = ztmp - x[j].z;
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < cutforcesq) {
+          jblk[nblk] = j;
+          tblk[nblk] = type[j];
+          rblk[nblk] = sqrt(rsq);
+          ++nblk;
         }
       }
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd reduction(+:rhoi)
+#endif
+      for (int k = 0; k < nblk; ++k) {
+        double pk = rblk[k]*rdr + 1.0;
+        int mk = static_cast<int> (pk);
+        mk = MIN(mk,nr-1);
+        pk -= mk;
+        pk = MIN(pk,1.0);
+        const int oi = offji[tblk[k]] + mk;
+        const int oj = offij[tblk[k]] + mk;
+        rhoi += ((rc3[oi]*pk + rc4[oi])*pk + rc5[oi])*pk + rc6[oi];
+        rhoblk[k] = ((rc3[oj]*pk + rc4[oj])*pk + rc5[oj])*pk + rc6[oj];
+      }
+
+      for (int k = 0; k < nblk; ++k) {
+        j = jblk[k];
+        if (NEWTON_PAIR || j < nlocal) rho_t[j] += rhoblk[k];
+      }
     }
+    rho_t[i] += rhoi;
   }
 
   // wait until all threads are done with computation
@@ -222,7 +315,19 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
   sync_threads();
 
   // compute forces on each atom
-  // loop over neighbors of my atoms
+  // loop over neighbors of my atoms in blocks, as for the densities
+
+  const double * _noalias const rc0 = rhor_soa[0];
+  const double * _noalias const rc1 = rhor_soa[1];
+  const double * _noalias const rc2 = rhor_soa[2];
+  const double * _noalias const zc0 = z2r_soa[0];
+  const double * _noalias const zc1 = z2r_soa[1];
+  const double * _noalias const zc2 = z2r_soa[2];
+  const double * _noalias const zc3 = z2r_soa[3];
+  const double * _noalias const zc4 = z2r_soa[4];
+  const double * _noalias const zc5 = z2r_soa[5];
+  const double * _noalias const zc6 = z2r_soa[6];
+  const double * _noalias const fpa = fp;
 
   for (ii = iifrom; ii < iito; ii++) {
     i = ilist[ii];
@@ -232,53 +337,82 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
     itype = type[i];
     fxtmp = fytmp = fztmp = 0.0;
     const double * _noalias const scale_i = scale[itype];
+    const int * _noalias const offij = rhor_off[itype];
+    const int * _noalias const offji = rhor_offT[itype];
+    const int * _noalias const offz = z2r_off[itype];
+    const double fpi = fp[i];
 
     jlist = firstneigh[i];
     jnum = numneigh[i];
     numforce[i] = 0;
 
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      j &= NEIGHMASK;
-
-      delx = xtmp - x[j].x;
-      dely = ytmp - x[j].y;
-      delz = ztmp - x[j].z;
-      rsq = delx*delx + dely*dely + delz*delz;
-
-      if (rsq < cutforcesq) {
-        ++numforce[i];
-        jtype = type[j];
-        r = sqrt(rsq);
-        p = r*rdr + 1.0;
-        m = static_cast<int> (p);
-        m = MIN(m,nr-1);
-        p -= m;
-        p = MIN(p,1.0);
-
-        // rhoip = derivative of (density at atom j due to atom i)
-        // rhojp = derivative of (density at atom i due to atom j)
-        // phi = pair potential energy
-        // phip = phi'
-        // z2 = phi * r
-        // z2p = (phi * r)' = (phi' r) + phi
-        // psip needs both fp[i] and fp[j] terms since r_ij appears in two
-        //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
-        //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
-
-        coeff = rhor_spline[type2rhor[itype][jtype]][m];
-        rhoip = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = rhor_spline[type2rhor[jtype][itype]][m];
-        rhojp = (coeff[0]*p + coeff[1])*p + coeff[2];
-        coeff = z2r_spline[type2z2r[itype][jtype]][m];
-        z2p = (coeff[0]*p + coeff[1])*p + coeff[2];
-        z2 = ((coeff[3]*p + coeff[4])*p + coeff[5])*p + coeff[6];
-
-        recip = 1.0/r;
-        phi = z2*recip;
-        phip = z2p*recip - phi*recip;
-        psip = fp[i]*rhojp + fp[j]*rhoip + phip;
-        fpair = -scale_i[jtype]*psip*recip;
+    for (jj = 0; jj < jnum;) {
+      int nblk = 0;
+      for (; (jj < jnum) && (nblk < NBLOCK); ++jj) {
+        j = jlist[jj];
+        j &= NEIGHMASK;
+
+        delx = xtmp - x[j].x;
+        dely = ytmp - x[j].y;
+        delz = ztmp - x[j].z;
+        rsq = delx*delx + dely*dely + delz*delz;
+
+        if (rsq < cutforcesq) {
+          jblk[nblk] = j;
+          tblk[nblk] = type[j];
+          rblk[nblk] = sqrt(rsq);
+          delxblk[nblk] = delx;
+          delyblk[nblk] = dely;
+          delzblk[nblk] = delz;
+          ++nblk;
+        }
+      }
+      numforce[i] += nblk;
+
+      // rhoip = derivative of (density at atom j due to atom i)
+      // rhojp = derivative of (density at atom i due to atom j)
+      // phi = pair potential energy
+      // phip = phi'
+      // z2 = phi * r
+      // z2p = (phi * r)' = (phi' r) + phi
+      // psip needs both fp[i] and fp[j] terms since r_ij appears in two
+      //   terms of embed eng: Fi(sum rho_ij) and Fj(sum rho_ji)
+      //   hence embed' = Fi(sum rho_ij) rhojp + Fj(sum rho_ji) rhoip
+
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for (int k = 0; k < nblk; ++k) {
+        const double rk = rblk[k];
+        double pk = rk*rdr + 1.0;
+        int mk = static_cast<int> (pk);
+        mk = MIN(mk,nr-1);
+        pk -= mk;
+        pk = MIN(pk,1.0);
+        const int jt = tblk[k];
+        const int oij = offij[jt] + mk;
+        const int oji = offji[jt] + mk;
+        const int oz = offz[jt] + mk;
+
+        const double rhoipk = (rc0[oij]*pk + rc1[oij])*pk + rc2[oij];
+        const double rhojpk = (rc0[oji]*pk + rc1[oji])*pk + rc2[oji];
+        const double z2pk = (zc0[oz]*pk + zc1[oz])*pk + zc2[oz];
+        const double z2k = ((zc3[oz]*pk + zc4[oz])*pk + zc5[oz])*pk + zc6[oz];
+
+        const double recipk = 1.0/rk;
+        const double phik = z2k*recipk;
+        const double phipk = z2pk*recipk - phik*recipk;
+        const double psipk = fpi*rhojpk + fpa[jblk[k]]*rhoipk + phipk;
+        fpairblk[k] = -scale_i[jt]*psipk*recipk;
+        if (EFLAG) evdwlblk[k] = scale_i[jt]*phik;
+      }
+
+      for (int k = 0; k < nblk; ++k) {
+        j = jblk[k];
+        fpair = fpairblk[k];
+        delx = delxblk[k];
+        dely = delyblk[k];
+        delz = delzblk[k];
 
         fxtmp += delx*fpair;
         fytmp += dely*fpair;
@@ -289,7 +423,7 @@ void PairEAMOMP::eval(int iifrom, int iito, ThrData * const thr)
           f[j].z -= delz*fpair;
         }
 
-        if (EFLAG) evdwl = scale_i[jtype]*phi;
+        if (EFLAG) evdwl = evdwlblk[k];
         if (EVFLAG) ev_tally_thr(this, i,j,nlocal,NEWTON_PAIR,
                                  evdwl,0.0,fpair,delx,dely,delz,thr);
       }
@@ -306,6 +440,8 @@ double PairEAMOMP::memory_usage()
 {
   double bytes = memory_usage_thr();
   bytes += PairEAM::memory_usage();
+  bytes += (double)7 * (nrhor + nz2r) * (nr + 1) * sizeof(double);
+  bytes += (double)3 * (atom->ntypes + 1) * (atom->ntypes + 1) * sizeof(int);
 
   return bytes;
 }
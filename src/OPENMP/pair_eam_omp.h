@@ -33,10 +33,20 @@ class PairEAMOMP : public PairEAM, public ThrOMP {
 
  public:
   PairEAMOMP(class LAMMPS *);
+  ~PairEAMOMP() override;
 
   void compute(int, int) override;
   double memory_usage() override;
 
+ protected:
+  // spline coefficients in structure-of-arrays layout: one contiguous
+  // array per coefficient with the tables of all type pairs concatenated
+
+  double **rhor_soa, **z2r_soa;
+  int **rhor_off, **rhor_offT, **z2r_off;    // offsets of the table of each type pair
+
+  void array2spline() override;
+
  private:
   template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
   void eval(int iifrom, int iito, ThrData *const thr);
@@ -0,0 +1,346 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_granular_omp.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "fix.h"
+#include "fix_neigh_history.h"
+#include "force.h"
+#include "granular_model.h"
+#include "math_extra.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "suffix.h"
+#include "update.h"
+
+#include "omp_compat.h"
+using namespace LAMMPS_NS;
+using namespace Granular_NS;
+using namespace MathExtra;
+
+/* ---------------------------------------------------------------------- */
+
+PairGranularOMP::PairGranularOMP(LAMMPS *lmp) :
+  PairGranular(lmp), ThrOMP(lmp, THR_PAIR)
+{
+  suffix_flag |= Suffix::OMP;
+  respa_enable = 0;
+  nthrmodels = 0;
+  nmodelsthr = 0;
+  models_thr = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairGranularOMP::~PairGranularOMP()
+{
+  destroy_models_thr();
+}
+
+/* ----------------------------------------------------------------------
+   models are modified by coeff(), init_style() and init_one(), so the
+   per-thread copies are discarded here and recreated on the next compute
+------------------------------------------------------------------------- */
+
+void PairGranularOMP::init_style()
+{
+  PairGranular::init_style();
+  destroy_models_thr();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::reset_dt()
+{
+  PairGranular::reset_dt();
+  for (int tid = 1; tid < nthrmodels; tid++)
+    for (int n = 0; n < nmodelsthr; n++) models_thr[tid][n]->dt = update->dt;
+}
+
+/* ----------------------------------------------------------------------
+   the granular models store per-contact intermediate data, so each
+   thread needs its own set. thread 0 uses the models of the base class.
+------------------------------------------------------------------------- */
+
+void PairGranularOMP::create_models_thr()
+{
+  nthrmodels = comm->nthreads;
+  nmodelsthr = nmodels;
+  models_thr = new GranularModel**[nthrmodels];
+  models_thr[0] = models_list;
+  for (int tid = 1; tid < nthrmodels; tid++) {
+    models_thr[tid] = new GranularModel*[nmodels];
+    for (int n = 0; n < nmodels; n++) {
+      models_thr[tid][n] = new GranularModel(Pointers::lmp);
+      models_thr[tid][n]->copy_model(models_list[n]);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::destroy_models_thr()
+{
+  for (int tid = 1; tid < nthrmodels; tid++) {
+    for (int n = 0; n < nmodelsthr; n++) delete models_thr[tid][n];
+    delete[] models_thr[tid];
+  }
+  delete[] models_thr;
+  models_thr = nullptr;
+  nthrmodels = 0;
+  nmodelsthr = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairGranularOMP::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  if (nthrmodels != comm->nthreads) {
+    destroy_models_thr();
+    create_models_thr();
+  }
+
+  const int history_update = update->setupflag == 0;
+  for (int tid = 0; tid < nthrmodels; tid++)
+    for (int n = 0; n < nmodelsthr; n++) models_thr[tid][n]->history_update = history_update;
+
+  // update rigid body info for owned & ghost atoms if using FixRigid masses
+  // body[i] = which body atom I is in, -1 if none
+  // mass_body = mass of each rigid body
+
+  if (fix_rigid && neighbor->ago == 0) {
+    int tmp;
+    int *body = (int *) fix_rigid->extract("body",tmp);
+    auto mass_body = (double *) fix_rigid->extract("masstotal",tmp);
+    if (atom->nmax > nmax) {
+      memory->destroy(mass_rigid);
+      nmax = atom->nmax;
+      memory->create(mass_rigid,nmax,"pair:mass_rigid");
+    }
+    int nlocal = atom->nlocal;
+    for (int i = 0; i < nlocal; i++)
+      if (body[i] >= 0) mass_rigid[i] = mass_body[body[i]];
+      else mass_rigid[i] = 0.0;
+    comm->forward_comm(this);
+  }
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+
+    if (evflag) {
+      if (heat_flag) {
+        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
+        else eval<1,1,0>(ifrom, ito, thr);
+      } else {
+        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
+        else eval<1,0,0>(ifrom, ito, thr);
+      }
+    } else {
+      if (heat_flag) {
+        if (force->newton_pair) eval<0,1,1>(ifrom, ito, thr);
+        else eval<0,1,0>(ifrom, ito, thr);
+      } else {
+        if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
+        else eval<0,0,0>(ifrom, ito, thr);
+      }
+    }
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+}
+
+/* ----------------------------------------------------------------------
+   contact history of pair I,J is stored with atom I, which is processed
+   by only one thread, so it can be updated without synchronization.
+   heat flow is not part of the per-thread data and updated atomically.
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int HEATFLAG, int NEWTON_PAIR>
+void PairGranularOMP::eval(int iifrom, int iito, ThrData * const thr)
+{
+  int i,j,k,ii,jj,jnum,itype,jtype;
+  double factor_lj,mi,mj,meff,dq;
+  double *forces,*torquesi,*torquesj;
+  int *jlist,*touch;
+  double *history,*allhistory;
+
+  double ** const x = atom->x;
+  double ** const v = atom->v;
+  double ** const omega = atom->omega;
+  const double * const radius = atom->radius;
+  const double * const rmass = atom->rmass;
+  const int * const type = atom->type;
+  const int * const mask = atom->mask;
+  const int nlocal = atom->nlocal;
+  const double * const special_lj = force->special_lj;
+  double * const * const f = thr->get_f();
+  double * const * const torque = thr->get_torque();
+  double * const heatflow = atom->heatflow;
+  const double * const temperature = atom->temperature;
+
+  const int * const ilist = list->ilist;
+  const int * const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+  int ** const firsttouch = use_history ? fix_history->firstflag : nullptr;
+  double ** const firsthistory = use_history ? fix_history->firstvalue : nullptr;
+
+  GranularModel ** const models = models_thr[thr->get_tid()];
+  GranularModel *model;
+
+  touch = nullptr;
+  allhistory = nullptr;
+
+  for (ii = iifrom; ii < iito; ++ii) {
+    i = ilist[ii];
+    itype = type[i];
+    if (use_history) {
+      touch = firsttouch[i];
+      allhistory = firsthistory[i];
+    }
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    double fi[3] = {0.0, 0.0, 0.0};
+    double ti[3] = {0.0, 0.0, 0.0};
+    double dqi = 0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      if (factor_lj == 0) continue;
+
+      jtype = type[j];
+      model = models[types_indices[itype][jtype]];
+
+      // Reset model and copy initial geometric data
+      model->xi = x[i];
+      model->xj = x[j];
+      model->radi = radius[i];
+      model->radj = radius[j];
+      if (use_history) model->touch = touch[jj];
+
+      if (!model->check_contact()) {
+        // unset non-touching neighbors
+        if (use_history) {
+          touch[jj] = 0;
+          history = &allhistory[size_history * jj];
+          for (k = 0; k < size_history; k++) history[k] = 0.0;
+        }
+        continue;
+      }
+
+      // if any history is needed
+      if (use_history) touch[jj] = 1;
+
+      // meff = effective mass of pair of particles
+      // if I or J part of rigid body, use body mass
+      // if I or J is frozen, meff is other particle
+      mi = rmass[i];
+      mj = rmass[j];
+      if (fix_rigid) {
+        if (mass_rigid[i] > 0.0) mi = mass_rigid[i];
+        if (mass_rigid[j] > 0.0) mj = mass_rigid[j];
+      }
+      meff = mi * mj / (mi + mj);
+      if (mask[i] & freeze_group_bit) meff = mj;
+      if (mask[j] & freeze_group_bit) meff = mi;
+
+      // Copy additional information and prepare force calculations
+      model->meff = meff;
+      model->vi = v[i];
+      model->vj = v[j];
+      model->omegai = omega[i];
+      model->omegaj = omega[j];
+      if (use_history) {
+        history = &allhistory[size_history * jj];
+        model->history = history;
+      }
+
+      if (HEATFLAG) {
+        model->Ti = temperature[i];
+        model->Tj = temperature[j];
+      }
+
+      model->calculate_forces();
+
+      forces = model->forces;
+      torquesi = model->torquesi;
+      torquesj = model->torquesj;
+
+      // apply forces & torques
+      scale3(factor_lj, forces);
+      add3(fi, forces, fi);
+
+      scale3(factor_lj, torquesi);
+      add3(ti, torquesi, ti);
+
+      if (NEWTON_PAIR || j < nlocal) {
+        sub3(f[j], forces, f[j]);
+        scale3(factor_lj, torquesj);
+        add3(torque[j], torquesj, torque[j]);
+      }
+
+      if (HEATFLAG) {
+        dq = model->dq;
+        dqi += dq;
+        if (NEWTON_PAIR || j < nlocal) {
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
+          heatflow[j] -= dq;
+        }
+      }
+
+      if (EVFLAG)
+        ev_tally_xyz_thr(this,i,j,nlocal,NEWTON_PAIR,0.0,0.0,forces[0],forces[1],forces[2],
+                         model->dx[0],model->dx[1],model->dx[2],thr);
+    }
+
+    add3(f[i], fi, f[i]);
+    add3(torque[i], ti, torque[i]);
+    if (HEATFLAG) {
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
+      heatflow[i] += dqi;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairGranularOMP::memory_usage()
+{
+  double bytes = memory_usage_thr();
+  bytes += PairGranular::memory_usage();
+
+  return bytes;
+}
@@ -0,0 +1,52 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(granular/omp,PairGranularOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_GRANULAR_OMP_H
+#define LMP_PAIR_GRANULAR_OMP_H
+
+#include "pair_granular.h"
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairGranularOMP : public PairGranular, public ThrOMP {
+
+ public:
+  PairGranularOMP(class LAMMPS *);
+  ~PairGranularOMP() override;
+
+  void compute(int, int) override;
+  void init_style() override;
+  void reset_dt() override;
+  double memory_usage() override;
+
+ protected:
+  int nthrmodels;                                  // number of threads with model lists
+  int nmodelsthr;                                  // number of models in per-thread lists
+  class Granular_NS::GranularModel ***models_thr;  // per-thread copies of models_list
+
+  void create_models_thr();
+  void destroy_models_thr();
+
+ private:
+  template <int EVFLAG, int HEATFLAG, int NEWTON_PAIR>
+  void eval(int ifrom, int ito, ThrData *const thr);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
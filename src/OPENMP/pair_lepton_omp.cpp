@@ -94,6 +94,8 @@ void PairLeptonOMP::eval(int iifrom, int iito, ThrData *const thr)
   const int *const *const firstneigh = list->firstneigh;
   double fxtmp, fytmp, fztmp;
 
+  // compile expressions, with tables they are only used below the inner cutoff
+
   std::vector<Lepton::CompiledExpression> pairforce;
   std::vector<Lepton::CompiledExpression> pairpot;
   try {
@@ -131,9 +133,24 @@ void PairLeptonOMP::eval(int iifrom, int iito, ThrData *const thr)
 
       if (rsq < cutsq[itype][jtype]) {
         const double r = sqrt(rsq);
-        const int idx = type2expression[itype][jtype];
-        pairforce[idx].getVariableReference("r") = r;
-        const double fpair = -pairforce[idx].evaluate() / r * factor_lj;
+        double fpair;
+        double evdwl = 0.0;
+
+        if (tableflag && (r >= tables[type2table[itype][jtype]].rinner)) {
+          double dedr;
+          const double e = table_lookup(tables[type2table[itype][jtype]], r, dedr);
+          fpair = -dedr / r * factor_lj;
+          if (EFLAG) evdwl = (e - offset[itype][jtype]) * factor_lj;
+        } else {
+          const int idx = type2expression[itype][jtype];
+          pairforce[idx].getVariableReference("r") = r;
+          fpair = -pairforce[idx].evaluate() / r * factor_lj;
+          if (EFLAG) {
+            pairpot[idx].getVariableReference("r") = r;
+            evdwl = pairpot[idx].evaluate() - offset[itype][jtype];
+            evdwl *= factor_lj;
+          }
+        }
 
         fxtmp += delx * fpair;
         fytmp += dely * fpair;
@@ -144,13 +161,6 @@ void PairLeptonOMP::eval(int iifrom, int iito, ThrData *const thr)
           f[j].z -= delz * fpair;
         }
 
-        double evdwl = 0.0;
-        if (EFLAG) {
-          pairpot[idx].getVariableReference("r") = r;
-          evdwl = pairpot[idx].evaluate() - offset[itype][jtype];
-          evdwl *= factor_lj;
-        }
-
         if (EVFLAG)
           ev_tally_thr(this, i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz, thr);
       }
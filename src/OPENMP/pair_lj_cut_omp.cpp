@@ -31,6 +31,7 @@ PairLJCutOMP::PairLJCutOMP(LAMMPS *lmp) :
 {
   suffix_flag |= Suffix::OMP;
   respa_enable = 0;
+  overlap_enable = 0;
   cut_respa = nullptr;
 }
 
@@ -233,10 +233,10 @@ void PairPeriLPSOMP::eval(int iifrom, int iito, ThrData * const thr)
 #pragma omp master
 #endif
   { // communicate dilatation (theta) of each particle
-    comm->forward_comm(this);
-    // communicate weighted volume (wvolume) upon every reneighbor
-    if (neighbor->ago == 0)
-      comm->forward_comm(fix_peri_neigh);
+    // and weighted volume (wvolume) upon every reneighbor in one exchange
+    comm->add_batch(this);
+    if (neighbor->ago == 0) comm->add_batch(fix_peri_neigh);
+    comm->forward_comm_batch();
   }
 
   sync_threads();
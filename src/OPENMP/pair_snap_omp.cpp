@@ -0,0 +1,323 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_snap_omp.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "sna.h"
+#include "suffix.h"
+
+#include "omp_compat.h"
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairSNAPOMP::PairSNAPOMP(LAMMPS *lmp) :
+  PairSNAP(lmp), ThrOMP(lmp, THR_PAIR)
+{
+  suffix_flag |= Suffix::OMP;
+  respa_enable = 0;
+  nsnathr = 0;
+  snathr = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairSNAPOMP::~PairSNAPOMP()
+{
+  destroy_sna_thr();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairSNAPOMP::destroy_sna_thr()
+{
+  for (int i = 0; i < nsnathr; i++) delete snathr[i];
+  delete[] snathr;
+  snathr = nullptr;
+  nsnathr = 0;
+}
+
+/* ----------------------------------------------------------------------
+   SNAP parameters may change, so per-thread SNA instances are recreated
+------------------------------------------------------------------------- */
+
+void PairSNAPOMP::coeff(int narg, char **arg)
+{
+  PairSNAP::coeff(narg, arg);
+  destroy_sna_thr();
+}
+
+/* ----------------------------------------------------------------------
+   create one SNA workspace per thread, reuse the SNA instance of the
+   base class for thread 0
+------------------------------------------------------------------------- */
+
+void PairSNAPOMP::init_style()
+{
+  PairSNAP::init_style();
+
+  if (nsnathr != comm->nthreads) {
+    destroy_sna_thr();
+    nsnathr = comm->nthreads;
+    snathr = new SNA*[nsnathr];
+    snathr[0] = nullptr;
+    for (int i = 1; i < nsnathr; i++) {
+      snathr[i] = new SNA(Pointers::lmp, rfac0, twojmax, rmin0, switchflag, bzeroflag,
+                          chemflag, bnormflag, wselfallflag, nelements, switchinnerflag);
+      snathr[i]->init();
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairSNAPOMP::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+  if (beta_max < inum) {
+    memory->grow(beta,inum,ncoeff,"PairSNAP:beta");
+    memory->grow(bispectrum,inum,ncoeff,"PairSNAP:bispectrum");
+    beta_max = inum;
+  }
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+
+    if (evflag) {
+      if (eflag) {
+        if (vflag_either) eval<1,1,1>(ifrom, ito, thr);
+        else eval<1,1,0>(ifrom, ito, thr);
+      } else {
+        if (vflag_either) eval<1,0,1>(ifrom, ito, thr);
+        else eval<1,0,0>(ifrom, ito, thr);
+      }
+    } else eval<0,0,0>(ifrom, ito, thr);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+}
+
+/* ----------------------------------------------------------------------
+   fused per-atom evaluation with the SNA workspace of the calling thread:
+   Ui is computed once per atom and used for the bispectrum, if needed,
+   and for Yi and the forces, beta_i only depends on the bispectrum of atom i
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int VFLAG>
+void PairSNAPOMP::eval(int iifrom, int iito, ThrData * const thr)
+{
+  int i,j,jnum,ninside;
+  double delx,dely,delz,rsq;
+  double fij[3];
+  int *jlist;
+
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const int nlocal = atom->nlocal;
+
+  const int * _noalias const ilist = list->ilist;
+  const int * _noalias const numneigh = list->numneigh;
+  int ** const firstneigh = list->firstneigh;
+
+  const int tid = thr->get_tid();
+  SNA *sna = tid ? snathr[tid] : snaptr;
+  const int bflag = quadraticflag || EFLAG;
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    i = ilist[ii];
+
+    const double xtmp = x[i].x;
+    const double ytmp = x[i].y;
+    const double ztmp = x[i].z;
+    const int itype = type[i];
+    const int ielem = map[itype];
+    const double radi = radelem[ielem];
+
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    // ensure rij, inside, wj, and rcutij are of size jnum
+
+    sna->grow_rij(jnum);
+
+    // rij[][3] = displacements between atom I and those neighbors
+    // inside = indices of neighbors of I within cutoff
+    // wj = weights for neighbors of I within cutoff
+    // rcutij = cutoffs for neighbors of I within cutoff
+    // note Rij sign convention => dU/dRij = dU/dRj = -dU/dRi
+
+    ninside = 0;
+    for (int jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      delx = x[j].x - xtmp;
+      dely = x[j].y - ytmp;
+      delz = x[j].z - ztmp;
+      rsq = delx*delx + dely*dely + delz*delz;
+      int jtype = type[j];
+      int jelem = map[jtype];
+
+      if (rsq < cutsq[itype][jtype]&&rsq>1e-20) {
+        sna->rij[ninside][0] = delx;
+        sna->rij[ninside][1] = dely;
+        sna->rij[ninside][2] = delz;
+        sna->inside[ninside] = j;
+        sna->wj[ninside] = wjelem[jelem];
+        sna->rcutij[ninside] = (radi + radelem[jelem])*rcutfac;
+        if (switchinnerflag) {
+          sna->sinnerij[ninside] = 0.5*(sinnerelem[ielem]+sinnerelem[jelem]);
+          sna->dinnerij[ninside] = 0.5*(dinnerelem[ielem]+dinnerelem[jelem]);
+        }
+        if (chemflag) sna->element[ninside] = jelem;
+        ninside++;
+      }
+    }
+
+    // compute Ui for atom I
+
+    if (chemflag)
+      sna->compute_ui(ninside, ielem);
+    else
+      sna->compute_ui(ninside, 0);
+
+    // compute bispectrum Bi, only needed for quadratic SNAP or energy
+
+    double *bveci = bispectrum[ii];
+    if (bflag) {
+      sna->compute_zi();
+      if (chemflag)
+        sna->compute_bi(ielem);
+      else
+        sna->compute_bi(0);
+      for (int icoeff = 0; icoeff < ncoeff; icoeff++)
+        bveci[icoeff] = sna->blist[icoeff];
+    }
+
+    // compute dE_i/dB_i = beta_i
+
+    const double *coeffi = coeffelem[ielem];
+    double *betai = beta[ii];
+
+    for (int icoeff = 0; icoeff < ncoeff; icoeff++)
+      betai[icoeff] = coeffi[icoeff+1];
+
+    if (quadraticflag) {
+      int k = ncoeff+1;
+      for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
+        double bvi = bveci[icoeff];
+        betai[icoeff] += coeffi[k]*bvi;
+        k++;
+        for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
+          double bvj = bveci[jcoeff];
+          betai[icoeff] += coeffi[k]*bvj;
+          betai[jcoeff] += coeffi[k]*bvi;
+          k++;
+        }
+      }
+    }
+
+    // for neighbors of I within cutoff:
+    // compute Fij = dEi/dRj = -dEi/dRi
+    // add to Fi, subtract from Fj
+    // scaling is that for type I
+
+    sna->compute_yi(betai);
+
+    const double scalei = scale[itype][itype];
+    double fxtmp = 0.0, fytmp = 0.0, fztmp = 0.0;
+
+    for (int jj = 0; jj < ninside; jj++) {
+      j = sna->inside[jj];
+      sna->compute_duidrj(jj);
+
+      sna->compute_deidrj(fij);
+
+      fxtmp += fij[0]*scalei;
+      fytmp += fij[1]*scalei;
+      fztmp += fij[2]*scalei;
+      f[j].x -= fij[0]*scalei;
+      f[j].y -= fij[1]*scalei;
+      f[j].z -= fij[2]*scalei;
+
+      // tally per-atom virial contribution
+
+      if (VFLAG)
+        ev_tally_xyz_thr(this,i,j,nlocal,/* newton_pair */ 1,0.0,0.0,
+                         fij[0],fij[1],fij[2],
+                         -sna->rij[jj][0],-sna->rij[jj][1],
+                         -sna->rij[jj][2],thr);
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+
+    // tally energy contribution
+
+    if (EFLAG) {
+
+      // evdwl = energy of atom I, sum over coeffs_k * Bi_k
+      // E = beta.B + 0.5*B^t.alpha.B
+
+      double evdwl = coeffi[0];
+
+      // linear contributions
+
+      for (int icoeff = 0; icoeff < ncoeff; icoeff++)
+        evdwl += coeffi[icoeff+1]*bveci[icoeff];
+
+      // quadratic contributions
+
+      if (quadraticflag) {
+        int k = ncoeff+1;
+        for (int icoeff = 0; icoeff < ncoeff; icoeff++) {
+          double bvi = bveci[icoeff];
+          evdwl += 0.5*coeffi[k++]*bvi*bvi;
+          for (int jcoeff = icoeff+1; jcoeff < ncoeff; jcoeff++) {
+            double bvj = bveci[jcoeff];
+            evdwl += coeffi[k++]*bvi*bvj;
+          }
+        }
+      }
+      evdwl *= scalei;
+      ev_tally_full_thr(this,i,2.0*evdwl,0.0,0.0,0.0,0.0,0.0,thr);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairSNAPOMP::memory_usage()
+{
+  double bytes = memory_usage_thr();
+  bytes += PairSNAP::memory_usage();
+  for (int i = 1; i < nsnathr; i++) bytes += snathr[i]->memory_usage();
+
+  return bytes;
+}
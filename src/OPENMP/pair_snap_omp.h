@@ -0,0 +1,49 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   This software is distributed under the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(snap/omp,PairSNAPOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_SNAP_OMP_H
+#define LMP_PAIR_SNAP_OMP_H
+
+#include "pair_snap.h"
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairSNAPOMP : public PairSNAP, public ThrOMP {
+
+ public:
+  PairSNAPOMP(class LAMMPS *);
+  ~PairSNAPOMP() override;
+
+  void compute(int, int) override;
+  void coeff(int, char **) override;
+  void init_style() override;
+  double memory_usage() override;
+
+ protected:
+  int nsnathr;             // number of per-thread SNA instances
+  class SNA **snathr;      // per-thread SNA workspaces
+
+  void destroy_sna_thr();
+
+ private:
+  template <int EVFLAG, int EFLAG, int VFLAG> void eval(int ifrom, int ito, ThrData *const thr);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
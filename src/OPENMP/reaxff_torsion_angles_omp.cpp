@@ -33,6 +33,7 @@
 #include "reaxff_api.h"
 
 #include <cmath>
+#include <vector>
 
 #define MIN_SINE 1e-10
 
@@ -55,6 +56,7 @@ namespace ReaxFF {
     double total_Etor = 0;
     double total_Econ = 0;
     int  nthreads = control->nthreads;
+    torsion_jkl_terms *tor_jkl = Torsion_JKL_Scratch(system, workspace, bonds, nthreads);
 
 #if defined(_OPENMP)
 #pragma omp parallel default(shared) reduction(+: total_Etor, total_Econ)
@@ -98,6 +100,11 @@ namespace ReaxFF {
 
       int tid = get_tid();
 
+      // terms that depend only on the j-k-l angle and the k-l bond,
+      // precomputed once per j-k bond instead of for every i-j-k-l tuple
+
+      torsion_jkl_terms *jkl = tor_jkl + (long) tid * workspace->tor_jkl_max;
+
       long reductionOffset = (system->N * tid);
       class PairReaxFFOMP *pair_reax_ptr;
       pair_reax_ptr = static_cast<class PairReaxFFOMP*>(system->pair_ptr);
@@ -158,7 +165,31 @@ namespace ReaxFF {
               exp_tor4_DjDk = exp(p_tor4  * (Delta_j + Delta_k));
               exp_tor34_inv = 1.0 / (1.0 + exp_tor3_DjDk + exp_tor4_DjDk);
               f11_DjDk = (2.0 + exp_tor3_DjDk) * exp_tor34_inv;
-
+              dfn11 = (-p_tor3 * exp_tor3_DjDk +
+                       (p_tor3 * exp_tor3_DjDk - p_tor4 * exp_tor4_DjDk) *
+                       (2.0 + exp_tor3_DjDk) * exp_tor34_inv) *
+                exp_tor34_inv;
+
+              for (pl = start_pj; pl < end_pj; ++pl) {
+                p_jkl = &(thb_intrs->select.three_body_list[pl]);
+                torsion_jkl_terms &t_jkl = jkl[pl - start_pj];
+
+                theta_jkl = p_jkl->theta;
+                sin_jkl = sin(theta_jkl);
+                cos_jkl = cos(theta_jkl);
+                //tan_jkl_i = 1. / tan(theta_jkl);
+                if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
+                  tan_jkl_i = cos_jkl / MIN_SINE;
+                else if (sin_jkl <= 0 && sin_jkl >= -MIN_SINE)
+                  tan_jkl_i = cos_jkl / -MIN_SINE;
+                else tan_jkl_i = cos_jkl /sin_jkl;
+
+                BOA_kl = bonds->select.bond_list[p_jkl->pthb].bo_data.BO - control->thb_cut;
+                t_jkl.sin_jkl = sin_jkl;
+                t_jkl.tan_jkl_i = tan_jkl_i;
+                t_jkl.exp_tor2_kl = exp(-p_tor2 * BOA_kl);
+                t_jkl.exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
+              }
 
               /* pick i up from j-k interaction where j is the central atom */
               for (pi = start_pk; pi < end_pk; ++pi) {
@@ -212,15 +243,9 @@ namespace ReaxFF {
                       r_kl = pbond_kl->d;
                       BOA_kl = bo_kl->BO - control->thb_cut;
 
-                      theta_jkl = p_jkl->theta;
-                      sin_jkl = sin(theta_jkl);
-                      cos_jkl = cos(theta_jkl);
-                      //tan_jkl_i = 1. / tan(theta_jkl);
-                      if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
-                        tan_jkl_i = cos_jkl / MIN_SINE;
-                      else if (sin_jkl <= 0 && sin_jkl >= -MIN_SINE)
-                        tan_jkl_i = cos_jkl / -MIN_SINE;
-                      else tan_jkl_i = cos_jkl /sin_jkl;
+                      const torsion_jkl_terms &t_jkl = jkl[pl - start_pj];
+                      sin_jkl = t_jkl.sin_jkl;
+                      tan_jkl_i = t_jkl.tan_jkl_i;
 
                       rvec_ScaledSum(dvec_li, 1., system->my_atoms[i].x,
                                      -1., system->my_atoms[l].x);
@@ -244,8 +269,8 @@ namespace ReaxFF {
                       /* torsion energy */
                       exp_tor1 = exp(fbp->p_tor1 *
                                      SQR(2.0 - bo_jk->BO_pi - f11_DjDk));
-                      exp_tor2_kl = exp(-p_tor2 * BOA_kl);
-                      exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
+                      exp_tor2_kl = t_jkl.exp_tor2_kl;
+                      exp_cot2_kl = t_jkl.exp_cot2_kl;
                       fn10 = (1.0 - exp_tor2_ij) * (1.0 - exp_tor2_jk) *
                         (1.0 - exp_tor2_kl);
 
@@ -255,11 +280,6 @@ namespace ReaxFF {
 
                       total_Etor += e_tor = fn10 * sin_ijk * sin_jkl * CV;
 
-                      dfn11 = (-p_tor3 * exp_tor3_DjDk +
-                               (p_tor3 * exp_tor3_DjDk - p_tor4 * exp_tor4_DjDk) *
-                               (2.0 + exp_tor3_DjDk) * exp_tor34_inv) *
-                        exp_tor34_inv;
-
                       CEtors1 = sin_ijk * sin_jkl * CV;
 
                       CEtors2 = -fn10 * 2.0 * fbp->p_tor1 * fbp->V2 * exp_tor1 *
@@ -132,6 +132,7 @@ namespace ReaxFF {
       double exp_pen2ij, exp_pen2jk, exp_pen3, exp_pen4, trm_pen34, exp_coa2;
       double dSBO1, dSBO2, SBO, SBO2, CSBO2, SBOp, prod_SBO, vlpadj;
       double CEval1, CEval2, CEval3, CEval4, CEval5, CEval6, CEval7, CEval8;
+      double sum_CEval5, sum_CEval6;
       double CEpen1, CEpen2, CEpen3;
       double e_ang, e_coa, e_pen;
       double CEcoa1, CEcoa2, CEcoa3, CEcoa4, CEcoa5;
@@ -147,7 +148,7 @@ namespace ReaxFF {
       three_body_header *thbh;
       three_body_parameters *thbp;
       three_body_interaction_data *p_ijk, *p_kji;
-      bond_data *pbond_ij, *pbond_jk, *pbond_jt;
+      bond_data *pbond_ij, *pbond_jk;
       bond_order_data *bo_ij, *bo_jk, *bo_jt;
 
       int tid = get_tid();
@@ -315,6 +316,30 @@ namespace ReaxFF {
 
         expval6 = exp(p_val6 * workspace->Delta_boc[j]);
 
+        // the penalty and coalition terms depend on atom j only
+
+        p_pen2 = system->reax_param.gp.l[19];
+        p_pen3 = system->reax_param.gp.l[20];
+        p_pen4 = system->reax_param.gp.l[21];
+        exp_pen3 = exp(-p_pen3 * workspace->Delta[j]);
+        exp_pen4 = exp(p_pen4 * workspace->Delta[j]);
+        trm_pen34 = 1.0 + exp_pen3 + exp_pen4;
+        f9_Dj = (2.0 + exp_pen3) / trm_pen34;
+        Cf9j = (-p_pen3 * exp_pen3 * trm_pen34 -
+                (2.0 + exp_pen3) * (-p_pen3 * exp_pen3 +
+                                    p_pen4 * exp_pen4)) /
+          SQR(trm_pen34);
+
+        p_coa2 = system->reax_param.gp.l[2];
+        p_coa3 = system->reax_param.gp.l[38];
+        p_coa4 = system->reax_param.gp.l[30];
+        exp_coa2 = exp(p_coa2 * workspace->Delta_val[j]);
+
+        // contributions of all angles centered on j to the bond order
+        // derivatives of all bonds of j are accumulated and applied once
+
+        sum_CEval5 = sum_CEval6 = 0.0;
+
         for (pi = start_j; pi < end_j; ++pi) {
           Set_Start_Index(pi, my_offset, thb_intrs);
           pbond_ij = &(bonds->select.bond_list[pi]);
@@ -449,20 +474,9 @@ namespace ReaxFF {
 
                     /* PENALTY ENERGY */
                     p_pen1 = thbp->p_pen1;
-                    p_pen2 = system->reax_param.gp.l[19];
-                    p_pen3 = system->reax_param.gp.l[20];
-                    p_pen4 = system->reax_param.gp.l[21];
 
                     exp_pen2ij = exp(-p_pen2 * SQR(BOA_ij - 2.0));
                     exp_pen2jk = exp(-p_pen2 * SQR(BOA_jk - 2.0));
-                    exp_pen3 = exp(-p_pen3 * workspace->Delta[j]);
-                    exp_pen4 = exp(p_pen4 * workspace->Delta[j]);
-                    trm_pen34 = 1.0 + exp_pen3 + exp_pen4;
-                    f9_Dj = (2.0 + exp_pen3) / trm_pen34;
-                    Cf9j = (-p_pen3 * exp_pen3 * trm_pen34 -
-                            (2.0 + exp_pen3) * (-p_pen3 * exp_pen3 +
-                                                p_pen4 * exp_pen4)) /
-                      SQR(trm_pen34);
 
                     total_Epen += e_pen =
                       p_pen1 * f9_Dj * exp_pen2ij * exp_pen2jk;
@@ -476,11 +490,7 @@ namespace ReaxFF {
 
                     /* COALITION ENERGY */
                     p_coa1 = thbp->p_coa1;
-                    p_coa2 = system->reax_param.gp.l[2];
-                    p_coa3 = system->reax_param.gp.l[38];
-                    p_coa4 = system->reax_param.gp.l[30];
 
-                    exp_coa2 = exp(p_coa2 * workspace->Delta_val[j]);
                     total_Ecoa += e_coa =
                       p_coa1 / (1. + exp_coa2) *
                       exp(-p_coa3 * SQR(workspace->total_bond_order[i]-BOA_ij)) *
@@ -505,17 +515,8 @@ namespace ReaxFF {
                     workspace->CdDeltaReduction[reductionOffset+i] += CEcoa4;
                     workspace->CdDeltaReduction[reductionOffset+k] += CEcoa5;
 
-                    for (t = start_j; t < end_j; ++t) {
-                      pbond_jt = &(bonds->select.bond_list[t]);
-                      bo_jt = &(pbond_jt->bo_data);
-                      temp_bo_jt = bo_jt->BO;
-                      temp = CUBE(temp_bo_jt);
-                      pBOjt7 = temp * temp * temp_bo_jt;
-
-                      bo_jt->Cdbo += (CEval6 * pBOjt7);
-                      bo_jt->Cdbopi += CEval5;
-                      bo_jt->Cdbopi2 += CEval5;
-                    }
+                    sum_CEval5 += CEval5;
+                    sum_CEval6 += CEval6;
 
                     rvec_ScaledAdd(workspace->f[j], CEval8, p_ijk->dcos_dj);
                     rvec_ScaledAdd(workspace->forceReduction[reductionOffset+i], CEval8, p_ijk->dcos_di);
@@ -551,6 +552,19 @@ namespace ReaxFF {
 
           Set_End_Index(pi, my_offset, thb_intrs);
         } // for (pi)
+
+        if ((sum_CEval5 != 0.0) || (sum_CEval6 != 0.0)) {
+          for (t = start_j; t < end_j; ++t) {
+            bo_jt = &(bonds->select.bond_list[t].bo_data);
+            temp_bo_jt = bo_jt->BO;
+            temp = CUBE(temp_bo_jt);
+            pBOjt7 = temp * temp * temp_bo_jt;
+
+            bo_jt->Cdbo += (sum_CEval6 * pBOjt7);
+            bo_jt->Cdbopi += sum_CEval5;
+            bo_jt->Cdbopi2 += sum_CEval5;
+          }
+        }
       } // for (j)
     } // end omp parallel
 
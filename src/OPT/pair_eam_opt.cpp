@@ -34,7 +34,11 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp) {}
+PairEAMOpt::PairEAMOpt(LAMMPS *lmp) : PairEAM(lmp)
+{
+  overlap_enable = 0;
+  full_enable = 0;
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -173,10 +173,10 @@ void PairPeriLPS::compute(int eflag, int vflag)
   compute_dilatation(0,nlocal);
 
   // communicate dilatation (theta) of each particle
-  comm->forward_comm(this);
-  // communicate wighted volume (wvolume) upon every reneighbor
-  if (neighbor->ago == 0)
-    comm->forward_comm(fix_peri_neigh);
+  // and weighted volume (wvolume) upon every reneighbor in one exchange
+  comm->add_batch(this);
+  if (neighbor->ago == 0) comm->add_batch(fix_peri_neigh);
+  comm->forward_comm_batch();
 
   // Volume-dependent part of the energy
   if (eflag) {
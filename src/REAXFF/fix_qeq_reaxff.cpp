@@ -84,8 +84,7 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   tolerance = utils::numeric(FLERR,arg[6],false,lmp);
   pertype_option = utils::strdup(arg[7]);
 
-  // dual CG support only available for OPENMP variant
-  // check for compatibility is in Fix::post_constructor()
+  // dual CG solves the s and t systems together
 
   dual_enabled = 0;
 
@@ -124,6 +123,7 @@ FixQEqReaxFF::FixQEqReaxFF(LAMMPS *lmp, int narg, char **arg) :
   q = nullptr;
   r = nullptr;
   d = nullptr;
+  z = nullptr;
 
   // H matrix
 
@@ -186,8 +186,6 @@ void FixQEqReaxFF::post_constructor()
       s_hist[i][j] = t_hist[i][j] = 0;
 
   pertype_parameters(pertype_option);
-  if (dual_enabled)
-    error->all(FLERR,"Dual keyword only supported with fix qeq/reaxff/omp");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -284,6 +282,7 @@ void FixQEqReaxFF::allocate_storage()
   memory->create(q,size,"qeq:q");
   memory->create(r,size,"qeq:r");
   memory->create(d,size,"qeq:d");
+  if (dual_enabled) memory->create(z,size,"qeq:z");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -304,6 +303,7 @@ void FixQEqReaxFF::deallocate_storage()
   memory->destroy(q);
   memory->destroy(r);
   memory->destroy(d);
+  memory->destroy(z);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -585,9 +585,13 @@ void FixQEqReaxFF::pre_force(int /*vflag*/)
 
   init_matvec();
 
-  matvecs_s = CG(b_s, s);       // CG on s - parallel
-  matvecs_t = CG(b_t, t);       // CG on t - parallel
-  matvecs = matvecs_s + matvecs_t;
+  if (dual_enabled) {
+    matvecs = dual_CG(b_s, b_t, s, t);
+  } else {
+    matvecs_s = CG(b_s, s);     // CG on s - parallel
+    matvecs_t = CG(b_t, t);     // CG on t - parallel
+    matvecs = matvecs_s + matvecs_t;
+  }
 
   calculate_Q();
 }
@@ -809,6 +813,223 @@ void FixQEqReaxFF::sparse_matvec(sparse_matrix *A, double *x, double *b)
 
 }
 
+/* ----------------------------------------------------------------------
+   solve H s = b1 and H t = b2 together with a single-reduction
+   preconditioned CG (Chronopoulos and Gear, J Comput Appl Math, 25, 153 (1989))
+   s and t components are interleaved in p, q, r, d and z so that both
+   systems share one forward comm, one matvec and one reverse comm per
+   iteration, and all dot products are combined into one allreduce
+   d holds the preconditioned residual u, q = H u, p the search direction
+   and z = H p, which is updated by recurrence instead of a second matvec
+------------------------------------------------------------------------- */
+
+int FixQEqReaxFF::dual_CG(double *b1, double *b2, double *x1, double *x2)
+{
+  int i, ii, jj, k, indxI;
+  double my_buf[6], buf[6];
+  double b_norm[2], gamma[2], delta[2], alpha[2], beta[2];
+  int converged[2], iters[2];
+
+  pack_flag = 5; // forward 2x d and reverse 2x q
+  dual_sparse_matvec(&H, x1, x2, q);
+  comm->reverse_comm(this); //Coll_Vector(q);
+
+  for (k = 0; k < 6; k++) my_buf[k] = 0.0;
+
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (atom->mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      r[indxI] = b1[ii] - q[indxI];
+      r[indxI+1] = b2[ii] - q[indxI+1];
+
+      d[indxI] = r[indxI] * Hdia_inv[ii]; //pre-condition
+      d[indxI+1] = r[indxI+1] * Hdia_inv[ii];
+
+      p[indxI] = p[indxI+1] = 0.0;
+      z[indxI] = z[indxI+1] = 0.0;
+
+      my_buf[0] += b1[ii] * b1[ii];
+      my_buf[1] += b2[ii] * b2[ii];
+      my_buf[2] += r[indxI] * d[indxI];
+      my_buf[3] += r[indxI+1] * d[indxI+1];
+    }
+  }
+
+  comm->forward_comm(this); //Dist_vector(d);
+  dual_sparse_matvec(&H, d, q);
+  comm->reverse_comm(this); //Coll_vector(q);
+
+  for (jj = 0; jj < nn; ++jj) {
+    ii = ilist[jj];
+    if (atom->mask[ii] & groupbit) {
+      indxI = 2 * ii;
+      my_buf[4] += q[indxI] * d[indxI];
+      my_buf[5] += q[indxI+1] * d[indxI+1];
+    }
+  }
+
+  MPI_Allreduce(my_buf, buf, 6, MPI_DOUBLE, MPI_SUM, world);
+
+  for (k = 0; k < 2; k++) {
+    b_norm[k] = sqrt(buf[k]);
+    gamma[k] = buf[2+k];
+    delta[k] = buf[4+k];
+    converged[k] = (sqrt(gamma[k]) / b_norm[k] <= tolerance);
+    iters[k] = 1;
+    alpha[k] = converged[k] ? 0.0 : gamma[k] / delta[k];
+    beta[k] = 0.0;
+  }
+
+  for (i = 1; i < imax && !(converged[0] && converged[1]); ++i) {
+
+    // update search directions, solutions and residuals of unconverged systems
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (atom->mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        if (!converged[0]) {
+          p[indxI] = d[indxI] + beta[0] * p[indxI];
+          z[indxI] = q[indxI] + beta[0] * z[indxI];
+          x1[ii] += alpha[0] * p[indxI];
+          r[indxI] -= alpha[0] * z[indxI];
+          d[indxI] = r[indxI] * Hdia_inv[ii];
+        }
+        if (!converged[1]) {
+          p[indxI+1] = d[indxI+1] + beta[1] * p[indxI+1];
+          z[indxI+1] = q[indxI+1] + beta[1] * z[indxI+1];
+          x2[ii] += alpha[1] * p[indxI+1];
+          r[indxI+1] -= alpha[1] * z[indxI+1];
+          d[indxI+1] = r[indxI+1] * Hdia_inv[ii];
+        }
+      }
+    }
+
+    comm->forward_comm(this); //Dist_vector(d);
+    dual_sparse_matvec(&H, d, q);
+    comm->reverse_comm(this); //Coll_vector(q);
+
+    // both (r,u) and (Hu,u) for both systems in a single reduction
+
+    for (k = 0; k < 4; k++) my_buf[k] = 0.0;
+
+    for (jj = 0; jj < nn; ++jj) {
+      ii = ilist[jj];
+      if (atom->mask[ii] & groupbit) {
+        indxI = 2 * ii;
+        my_buf[0] += r[indxI] * d[indxI];
+        my_buf[1] += r[indxI+1] * d[indxI+1];
+        my_buf[2] += q[indxI] * d[indxI];
+        my_buf[3] += q[indxI+1] * d[indxI+1];
+      }
+    }
+
+    MPI_Allreduce(my_buf, buf, 4, MPI_DOUBLE, MPI_SUM, world);
+
+    for (k = 0; k < 2; k++) {
+      if (converged[k]) continue;
+      iters[k] = i + 1;
+      if (sqrt(buf[k]) / b_norm[k] <= tolerance) {
+        converged[k] = 1;
+        continue;
+      }
+      beta[k] = buf[k] / gamma[k];
+      alpha[k] = buf[k] / (buf[2+k] - beta[k] * buf[k] / alpha[k]);
+      gamma[k] = buf[k];
+    }
+  }
+
+  matvecs_s = iters[0];
+  matvecs_t = iters[1];
+
+  if ((i >= imax) && maxwarn && (comm->me == 0))
+    error->warning(FLERR,fmt::format("Fix qeq/reaxff dual CG convergence failed "
+                                     "after {} iterations at step {}",
+                                     i,update->ntimestep));
+  return matvecs_s + matvecs_t;
+}
+
+/* ----------------------------------------------------------------------
+   b = H [x1 x2], result interleaved in b
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x1, double *x2, double *b)
+{
+  int i, j, itr_j, indxI, indxJ;
+  int ii;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x1[i];
+      b[indxI+1] = eta[atom->type[i]] * x2[i];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = atom->nlocal; i < nall; ++i) {
+    indxI = 2 * i;
+    b[indxI] = b[indxI+1] = 0;
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x1[j];
+        b[indxI+1] += A->val[itr_j] * x2[j];
+        b[indxJ] += A->val[itr_j] * x1[i];
+        b[indxJ+1] += A->val[itr_j] * x2[i];
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   b = H x with x and b both interleaved
+------------------------------------------------------------------------- */
+
+void FixQEqReaxFF::dual_sparse_matvec(sparse_matrix *A, double *x, double *b)
+{
+  int i, j, itr_j, indxI, indxJ;
+  int ii;
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      b[indxI] = eta[atom->type[i]] * x[indxI];
+      b[indxI+1] = eta[atom->type[i]] * x[indxI+1];
+    }
+  }
+
+  int nall = atom->nlocal + atom->nghost;
+  for (i = atom->nlocal; i < nall; ++i) {
+    indxI = 2 * i;
+    b[indxI] = b[indxI+1] = 0;
+  }
+
+  for (ii = 0; ii < nn; ++ii) {
+    i = ilist[ii];
+    if (atom->mask[i] & groupbit) {
+      indxI = 2 * i;
+      for (itr_j=A->firstnbr[i]; itr_j<A->firstnbr[i]+A->numnbrs[i]; itr_j++) {
+        j = A->jlist[itr_j];
+        indxJ = 2 * j;
+        b[indxI] += A->val[itr_j] * x[indxJ];
+        b[indxI+1] += A->val[itr_j] * x[indxJ+1];
+        b[indxJ] += A->val[itr_j] * x[indxI];
+        b[indxJ+1] += A->val[itr_j] * x[indxI+1];
+      }
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixQEqReaxFF::calculate_Q()
@@ -945,7 +1166,7 @@ double FixQEqReaxFF::memory_usage()
   bytes += (double)m_cap * sizeof(double);
 
   if (dual_enabled)
-    bytes += (double)atom->nmax*4 * sizeof(double); // double size for q, d, r, and p
+    bytes += (double)atom->nmax*6 * sizeof(double); // double size for q, d, r, and p, plus z
 
   return bytes;
 }
@@ -97,6 +97,7 @@ class FixQEqReaxFF : public Fix {
 
   //CG storage
   double *p, *q, *r, *d;
+  double *z;    // H*p for the single-reduction dual CG
   int imax, maxwarn;
 
   char *pertype_option;    // argument to determine how per-type info is obtained
@@ -141,6 +142,10 @@ class FixQEqReaxFF : public Fix {
   // dual CG support
   int dual_enabled;            // 0: Original, separate s & t optimization; 1: dual optimization
   int matvecs_s, matvecs_t;    // Iteration count for each system
+
+  virtual int dual_CG(double *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *, double *);
+  virtual void dual_sparse_matvec(sparse_matrix *, double *, double *);
 };
 
 }    // namespace LAMMPS_NS
@@ -115,6 +115,12 @@ namespace ReaxFF {
       sfree(workspace->forceReduction);
     if (workspace->valence_angle_atom_myoffset)
       sfree(workspace->valence_angle_atom_myoffset);
+
+    /* torsion */
+
+    sfree(workspace->tor_jkl);
+    workspace->tor_jkl = nullptr;
+    workspace->tor_jkl_max = 0;
   }
 
   void Allocate_Workspace(control_params *control, storage *workspace, int total_cap)
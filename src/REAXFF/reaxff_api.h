@@ -151,6 +151,7 @@ extern double Calculate_Omega(rvec, double, rvec, double, rvec, double, rvec, do
                               rvec, rvec, rvec);
 extern void Torsion_Angles(reax_system *, control_params *, simulation_data *, storage *,
                            reax_list **);
+extern torsion_jkl_terms *Torsion_JKL_Scratch(reax_system *, storage *, reax_list *, int);
 
 // valence angles
 
@@ -30,6 +30,7 @@
 #include "pair.h"
 
 #include <cmath>
+#include <vector>
 
 namespace ReaxFF {
   double Calculate_Omega(rvec dvec_ij, double r_ij, rvec dvec_jk, double r_jk,
@@ -111,6 +112,29 @@ namespace ReaxFF {
     return omega;
   }
 
+  /* ----------------------------------------------------------------------
+     return buffer for the terms of the j-k-l angles of one j-k bond for
+     each of nthreads threads, the entries of thread tid start at
+     tid * workspace->tor_jkl_max. a bond has fewer three-body entries
+     than its atom has bonds, so the buffer only grows with the latter.
+  ------------------------------------------------------------------------- */
+
+  torsion_jkl_terms *Torsion_JKL_Scratch(reax_system *system, storage *workspace,
+                                         reax_list *bonds, int nthreads)
+  {
+    int maxjkl = 1;
+    for (int i = 0; i < system->N; ++i) maxjkl = MAX(maxjkl, Num_Entries(i, bonds));
+
+    if (maxjkl > workspace->tor_jkl_max) {
+      sfree(workspace->tor_jkl);
+      workspace->tor_jkl_max = maxjkl;
+      workspace->tor_jkl = (torsion_jkl_terms *)
+        smalloc(system->error_ptr, sizeof(torsion_jkl_terms) * (rc_bigint) maxjkl * nthreads,
+                "tor_jkl");
+    }
+    return workspace->tor_jkl;
+  }
+
   void Torsion_Angles(reax_system *system, control_params *control,
                       simulation_data *data, storage *workspace,
                       reax_list **lists)
@@ -156,6 +180,11 @@ namespace ReaxFF {
     double delil[3], deljl[3], delkl[3];
     double eng_tmp, fi_tmp[3], fj_tmp[3], fk_tmp[3];
 
+    // terms that depend only on the j-k-l angle and the k-l bond,
+    // precomputed once per j-k bond instead of for every i-j-k-l tuple
+
+    torsion_jkl_terms *jkl = Torsion_JKL_Scratch(system, workspace, bonds, 1);
+
     natoms = system->n;
 
     for (j = 0; j < natoms; ++j) {
@@ -200,6 +229,31 @@ namespace ReaxFF {
             exp_tor4_DjDk = exp(p_tor4  * (Delta_j + Delta_k));
             exp_tor34_inv = 1.0 / (1.0 + exp_tor3_DjDk + exp_tor4_DjDk);
             f11_DjDk = (2.0 + exp_tor3_DjDk) * exp_tor34_inv;
+            dfn11 = (-p_tor3 * exp_tor3_DjDk +
+                     (p_tor3 * exp_tor3_DjDk - p_tor4 * exp_tor4_DjDk) *
+                     (2.0 + exp_tor3_DjDk) * exp_tor34_inv) *
+              exp_tor34_inv;
+
+            for (pl = start_pj; pl < end_pj; ++pl) {
+              p_jkl = &(thb_intrs->select.three_body_list[pl]);
+              torsion_jkl_terms &t_jkl = jkl[pl - start_pj];
+
+              theta_jkl = p_jkl->theta;
+              sin_jkl = sin(theta_jkl);
+              cos_jkl = cos(theta_jkl);
+              //tan_jkl_i = 1. / tan(theta_jkl);
+              if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
+                tan_jkl_i = cos_jkl / MIN_SINE;
+              else if (sin_jkl <= 0 && sin_jkl >= -MIN_SINE)
+                tan_jkl_i = cos_jkl / -MIN_SINE;
+              else tan_jkl_i = cos_jkl /sin_jkl;
+
+              BOA_kl = bonds->select.bond_list[p_jkl->pthb].bo_data.BO - control->thb_cut;
+              t_jkl.sin_jkl = sin_jkl;
+              t_jkl.tan_jkl_i = tan_jkl_i;
+              t_jkl.exp_tor2_kl = exp(-p_tor2 * BOA_kl);
+              t_jkl.exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
+            }
 
             for (pi = start_pk; pi < end_pk; ++pi) {
               p_ijk = &(thb_intrs->select.three_body_list[pi]);
@@ -244,15 +298,9 @@ namespace ReaxFF {
                     r_kl = pbond_kl->d;
                     BOA_kl = bo_kl->BO - control->thb_cut;
 
-                    theta_jkl = p_jkl->theta;
-                    sin_jkl = sin(theta_jkl);
-                    cos_jkl = cos(theta_jkl);
-                    //tan_jkl_i = 1. / tan(theta_jkl);
-                    if (sin_jkl >= 0 && sin_jkl <= MIN_SINE)
-                      tan_jkl_i = cos_jkl / MIN_SINE;
-                    else if (sin_jkl <= 0 && sin_jkl >= -MIN_SINE)
-                      tan_jkl_i = cos_jkl / -MIN_SINE;
-                    else tan_jkl_i = cos_jkl /sin_jkl;
+                    const torsion_jkl_terms &t_jkl = jkl[pl - start_pj];
+                    sin_jkl = t_jkl.sin_jkl;
+                    tan_jkl_i = t_jkl.tan_jkl_i;
 
                     rvec_ScaledSum(dvec_li, 1., system->my_atoms[i].x,
                                     -1., system->my_atoms[l].x);
@@ -276,8 +324,8 @@ namespace ReaxFF {
                     /* torsion energy */
                     exp_tor1 = exp(fbp->p_tor1 *
                                     SQR(2.0 - bo_jk->BO_pi - f11_DjDk));
-                    exp_tor2_kl = exp(-p_tor2 * BOA_kl);
-                    exp_cot2_kl = exp(-p_cot2 * SQR(BOA_kl - 1.5));
+                    exp_tor2_kl = t_jkl.exp_tor2_kl;
+                    exp_cot2_kl = t_jkl.exp_cot2_kl;
                     fn10 = (1.0 - exp_tor2_ij) * (1.0 - exp_tor2_jk) *
                       (1.0 - exp_tor2_kl);
 
@@ -287,11 +335,6 @@ namespace ReaxFF {
 
                     data->my_en.e_tor += e_tor = fn10 * sin_ijk * sin_jkl * CV;
 
-                    dfn11 = (-p_tor3 * exp_tor3_DjDk +
-                             (p_tor3 * exp_tor3_DjDk - p_tor4 * exp_tor4_DjDk) *
-                             (2.0 + exp_tor3_DjDk) * exp_tor34_inv) *
-                      exp_tor34_inv;
-
                     CEtors1 = sin_ijk * sin_jkl * CV;
 
                     CEtors2 = -fn10 * 2.0 * fbp->p_tor1 * fbp->V2 * exp_tor1 *
@@ -309,6 +309,10 @@ struct sparse_matrix {
   sparse_matrix_entry *entries;
 };
 
+struct torsion_jkl_terms {
+  double sin_jkl, tan_jkl_i, exp_tor2_kl, exp_cot2_kl;
+};
+
 struct reallocate_data {
   int num_far;
   int H, Htop;
@@ -341,6 +345,10 @@ struct storage {
   double *CdDeltaReduction;
   int *valence_angle_atom_myoffset;
 
+  /* torsion */
+  torsion_jkl_terms *tor_jkl;    // per-thread terms of the j-k-l angles of a j-k bond
+  int tor_jkl_max;               // # of entries per thread in tor_jkl
+
   /* acks2 */
   double *s;
 
@@ -261,12 +261,13 @@ Atom::Atom(LAMMPS *_lmp) : Pointers(_lmp)
   tag_enable = 1;
   map_style = map_user = MAP_NONE;
   map_tag_max = -1;
-  map_maxarray = map_nhash = map_nbucket = -1;
+  map_maxarray = map_nhash = -1;
+  map_nused = map_nslot = map_mask = 0;
+  map_shift = 63;
 
   max_same = 0;
   sametag = nullptr;
   map_array = nullptr;
-  map_bucket = nullptr;
   map_hash = nullptr;
 
   unique_tags = nullptr;
@@ -1038,11 +1039,12 @@ void Atom::deallocate_topology()
 /* ----------------------------------------------------------------------
    unpack N lines from Atom section of data file
    call style-specific routine to parse line
+   if allflag, keep all atoms inside global box, not just my sub-domain
 ------------------------------------------------------------------------- */
 
 void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
                       int type_offset, int shiftflag, double *shift,
-                      int labelflag, int *ilabel)
+                      int labelflag, int *ilabel, int allflag)
 {
   int xptr,iptr;
   imageint imagedata;
@@ -1065,13 +1067,16 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     }
   }
 
-  if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3))
-    error->all(FLERR,"Incorrect format in {}: {}", location, utils::trim(buf));
+  if ((nwords != avec->size_data_atom) && (nwords != avec->size_data_atom + 3)) {
+    if (allflag) error->one(FLERR,"Incorrect format in {}: {}", location, utils::trim(buf));
+    else error->all(FLERR,"Incorrect format in {}: {}", location, utils::trim(buf));
+  }
 
   *next = '\n';
   // set bounds for my proc
   // if periodic and I am lo/hi proc, adjust bounds by EPSILON
   // ensures all data atoms will be owned even with round-off
+  // if allflag, use bounds of entire box, caller migrates atoms to owning procs
 
   int triclinic = domain->triclinic;
 
@@ -1094,7 +1099,22 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
     sublo[2] = domain->sublo_lamda[2]; subhi[2] = domain->subhi_lamda[2];
   }
 
-  if (comm->layout != Comm::LAYOUT_TILED) {
+  if (allflag) {
+    for (int idim = 0; idim < 3; idim++) {
+      if (triclinic == 0) {
+        sublo[idim] = domain->boxlo[idim];
+        subhi[idim] = domain->boxhi[idim];
+      } else {
+        sublo[idim] = 0.0;
+        subhi[idim] = 1.0;
+      }
+      if (domain->periodicity[idim]) {
+        sublo[idim] -= epsilon[idim];
+        subhi[idim] += epsilon[idim];
+      }
+    }
+
+  } else if (comm->layout != Comm::LAYOUT_TILED) {
     if (domain->xperiodic) {
       if (comm->myloc[0] == 0) sublo[0] -= epsilon[0];
       if (comm->myloc[0] == comm->procgrid[0]-1) subhi[0] += epsilon[0];
@@ -1147,15 +1167,18 @@ void Atom::data_atoms(int n, char *buf, tagint id_offset, tagint mol_offset,
       // skip over empty or comment lines
     } else if ((nvalues < nwords) ||
                ((nvalues > nwords) && (!utils::strmatch(values[nwords],"^#")))) {
-      error->all(FLERR, "Incorrect format in {}: {}", location, utils::trim(buf));
+      if (allflag) error->one(FLERR, "Incorrect format in {}: {}", location, utils::trim(buf));
+      else error->all(FLERR, "Incorrect format in {}: {}", location, utils::trim(buf));
     } else {
       int imx = 0, imy = 0, imz = 0;
       if (imageflag) {
         imx = utils::inumeric(FLERR,values[iptr],false,lmp);
         imy = utils::inumeric(FLERR,values[iptr+1],false,lmp);
         imz = utils::inumeric(FLERR,values[iptr+2],false,lmp);
-        if ((domain->dimension == 2) && (imz != 0))
-          error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+        if ((domain->dimension == 2) && (imz != 0)) {
+          if (allflag) error->one(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+          else error->all(FLERR,"Z-direction image flag must be 0 for 2d-systems");
+        }
         if ((!domain->xperiodic) && (imx != 0)) { reset_image_flag[0] = true; imx = 0; }
         if ((!domain->yperiodic) && (imy != 0)) { reset_image_flag[1] = true; imy = 0; }
         if ((!domain->zperiodic) && (imz != 0)) { reset_image_flag[2] = true; imz = 0; }
@@ -3136,8 +3159,7 @@ double Atom::memory_usage()
   if (map_style == MAP_ARRAY)
     bytes += memory->usage(map_array,map_maxarray);
   else if (map_style == MAP_HASH) {
-    bytes += (double)map_nbucket*sizeof(int);
-    bytes += (double)map_nhash*sizeof(HashElem);
+    bytes += (double)map_nslot*sizeof(HashElem);
   }
   if (maxnext) {
     bytes += memory->usage(next,maxnext);
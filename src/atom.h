@@ -328,7 +328,7 @@ class Atom : protected Pointers {
 
   void deallocate_topology();
 
-  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *);
+  void data_atoms(int, char *, tagint, tagint, int, int, double *, int, int *, int = 0);
   void data_vels(int, char *, tagint);
   void data_bonds(int, char *, int *, tagint, int, int, int *);
   void data_angles(int, char *, int *, tagint, int, int, int *);
@@ -388,7 +388,7 @@ class Atom : protected Pointers {
     if (map_style == 1)
       return map_array[global];
     else if (map_style == 2)
-      return map_find_hash(global);
+      return map_probe(global);
     else
       return -1;
   };
@@ -407,18 +407,41 @@ class Atom : protected Pointers {
   int *map_array;      // direct map via array that holds map_tag_max
   int map_maxarray;    // allocated size of map_array (1 larger than this)
 
-  struct HashElem {    // hashed map
-    tagint global;     // key to search on = global ID
+  struct HashElem {    // hashed map, open addressing with linear probing
+    tagint global;     // key to search on = global ID, -1 if slot is empty
     int local;         // value associated with key = local index
-    int next;          // next entry in this bucket, -1 if last
   };
   int map_nhash;         // # of entries hash table can hold
   int map_nused;         // # of actual entries in hash table
-  int map_free;          // ptr to 1st unused entry in hash table
-  int map_nbucket;       // # of hash buckets
-  int *map_bucket;       // ptr to 1st entry in each bucket
+  int map_nslot;         // # of slots in hash table, power of 2
+  int map_mask;          // map_nslot - 1
+  int map_shift;         // right shift that turns hashed key into slot
   HashElem *map_hash;    // hash table
 
+  // home slot of a global ID via Fibonacci hashing
+  // spreads out both dense and strided ranges of atom IDs
+
+  inline int map_slot(tagint global) const
+  {
+    return static_cast<int>(((uint64_t) global * 0x9E3779B97F4A7C15ULL) >> map_shift);
+  }
+
+  // lookup global ID in hash table, return local index or -1
+
+  inline int map_probe(tagint global) const
+  {
+    int islot = map_slot(global);
+    while (map_hash[islot].global != global) {
+      if (map_hash[islot].global < 0) return -1;
+      islot = (islot + 1) & map_mask;
+    }
+    return map_hash[islot].local;
+  }
+
+  void map_alloc(int);
+  int map_insert(tagint, int);
+  void map_remove(tagint);
+
   int max_same;    // allocated size of sametag
 
   // spatial sorting of atoms
@@ -435,7 +458,6 @@ class Atom : protected Pointers {
 
   void set_atomflag_defaults();
   void setup_sort_bins();
-  int next_prime(int);
 };
 
 }    // namespace LAMMPS_NS
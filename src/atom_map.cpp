@@ -18,8 +18,6 @@
 #include "error.h"
 #include "memory.h"
 
-#include <cmath>
-
 using namespace LAMMPS_NS;
 
 #define EXTRA 1000
@@ -30,9 +28,9 @@ using namespace LAMMPS_NS;
      array length = 1 to map_tag_max
      set entire array to -1 as initial values
    for hash option:
-     map_nhash = length of hash table
-     map_nbucket = # of hash buckets, prime larger than map_nhash * 2
-       so buckets will only be filled with 0 or 1 atoms on average
+     map_nhash = # of atoms the hash table is sized for
+     map_nslot = # of slots, power of 2 at least map_nhash * 2
+       so table is at most half full and probe sequences stay short
 ------------------------------------------------------------------------- */
 
 void Atom::map_init(int check)
@@ -50,17 +48,14 @@ void Atom::map_init(int check)
 
   // if not recreating:
   // for array, initialize current map_tag_max values
-  // for hash, set all buckets to empty, put all entries in free list
+  // for hash, set all slots to empty
 
   if (!recreate) {
     if (map_style == MAP_ARRAY) {
       for (int i = 0; i <= map_tag_max; i++) map_array[i] = -1;
     } else {
-      for (int i = 0; i < map_nbucket; i++) map_bucket[i] = -1;
+      for (int i = 0; i < map_nslot; i++) map_hash[i].global = -1;
       map_nused = 0;
-      map_free = 0;
-      for (int i = 0; i < map_nhash; i++) map_hash[i].next = i+1;
-      if (map_nhash > 0) map_hash[map_nhash-1].next = -1;
     }
 
   // recreating: delete old map and create new one for array or hash
@@ -85,24 +80,7 @@ void Atom::map_init(int check)
       map_nhash *= 2;
       map_nhash = MAX(map_nhash,1000);
 
-      // map_nbucket = prime just larger than map_nhash
-      // next_prime() should be fast enough,
-      //   about 10% of odd integers are prime above 1M
-
-      map_nbucket = next_prime(map_nhash);
-
-      // set all buckets to empty
-      // set hash to map_nhash in length
-      // put all hash entries in free list and point them to each other
-
-      map_bucket = new int[map_nbucket];
-      for (int i = 0; i < map_nbucket; i++) map_bucket[i] = -1;
-
-      map_hash = new HashElem[map_nhash];
-      map_nused = 0;
-      map_free = 0;
-      for (int i = 0; i < map_nhash; i++) map_hash[i].next = i+1;
-      map_hash[map_nhash-1].next = -1;
+      map_alloc(map_nhash);
     }
   }
 }
@@ -123,35 +101,10 @@ void Atom::map_clear()
     }
 
   } else {
-    int previous,ibucket,index;
-    tagint global;
     int nall = nlocal + nghost;
     for (int i = 0; i < nall; i++) {
       if (sametag) sametag[i] = -1;
-
-      // search for key
-      // if don't find it, done
-
-      previous = -1;
-      global = tag[i];
-      ibucket = global % map_nbucket;
-      index = map_bucket[ibucket];
-      while (index > -1) {
-        if (map_hash[index].global == global) break;
-        previous = index;
-        index = map_hash[index].next;
-      }
-      if (index == -1) continue;
-
-      // delete the hash entry and add it to free list
-      // special logic if entry is 1st in the bucket
-
-      if (previous == -1) map_bucket[ibucket] = map_hash[index].next;
-      else map_hash[previous].next = map_hash[index].next;
-
-      map_hash[index].next = map_free;
-      map_free = index;
-      map_nused--;
+      if (map_nused) map_remove(tag[i]);
     }
   }
 }
@@ -200,42 +153,12 @@ void Atom::map_set()
       memory->create(sametag,max_same,"atom:sametag");
     }
 
-    int previous,ibucket,index;
-    tagint global;
+    // build table in one reverse sweep over the tag array
+    // map_insert() returns the index previously stored for an ID,
+    //   which is the next nearest image of the same atom
 
-    for (int i = nall-1; i >= 0 ; i--) {
-      sametag[i] = map_find_hash(tag[i]);
-
-      // search for key
-      // if found it, just overwrite local value with index
-
-      previous = -1;
-      global = tag[i];
-      ibucket = global % map_nbucket;
-      index = map_bucket[ibucket];
-      while (index > -1) {
-        if (map_hash[index].global == global) break;
-        previous = index;
-        index = map_hash[index].next;
-      }
-      if (index > -1) {
-        map_hash[index].local = i;
-        continue;
-      }
-
-      // take one entry from free list
-      // add the new global/local pair as entry at end of bucket list
-      // special logic if this entry is 1st in bucket
-
-      index = map_free;
-      map_free = map_hash[map_free].next;
-      if (previous == -1) map_bucket[ibucket] = index;
-      else map_hash[previous].next = index;
-      map_hash[index].global = global;
-      map_hash[index].local = i;
-      map_hash[index].next = -1;
-      map_nused++;
-    }
+    for (int i = nall-1; i >= 0 ; i--)
+      sametag[i] = map_insert(tag[i],i);
   }
 }
 
@@ -243,42 +166,14 @@ void Atom::map_set()
    set global to local map for one atom
    for hash table option:
      global ID may already be in table if atom was already set
-   called by Special class
+     table grows if needed, since IDs need not be my own or ghost atoms
+   called by Special and FixShake classes
 ------------------------------------------------------------------------- */
 
 void Atom::map_one(tagint global, int local)
 {
   if (map_style == MAP_ARRAY) map_array[global] = local;
-  else {
-    // search for key
-    // if found it, just overwrite local value with index
-
-    int previous = -1;
-    int ibucket = global % map_nbucket;
-    int index = map_bucket[ibucket];
-    while (index > -1) {
-      if (map_hash[index].global == global) break;
-      previous = index;
-      index = map_hash[index].next;
-    }
-    if (index > -1) {
-      map_hash[index].local = local;
-      return;
-    }
-
-    // take one entry from free list
-    // add the new global/local pair as entry at end of bucket list
-    // special logic if this entry is 1st in bucket
-
-    index = map_free;
-    map_free = map_hash[map_free].next;
-    if (previous == -1) map_bucket[ibucket] = index;
-    else map_hash[previous].next = index;
-    map_hash[index].global = global;
-    map_hash[index].local = local;
-    map_hash[index].next = -1;
-    map_nused++;
-  }
+  else map_insert(global,local);
 }
 
 /* ----------------------------------------------------------------------
@@ -334,53 +229,110 @@ void Atom::map_delete()
     memory->destroy(map_array);
     map_array = nullptr;
   } else {
-    if (map_nhash) {
-      delete [] map_bucket;
-      delete [] map_hash;
-      map_bucket = nullptr;
-      map_hash = nullptr;
-    }
-    map_nhash = map_nbucket = 0;
+    delete[] map_hash;
+    map_hash = nullptr;
+    map_nhash = map_nslot = map_mask = map_nused = 0;
   }
 }
 
 /* ----------------------------------------------------------------------
    lookup global ID in hash table, return local index
-   called by map() in atom.h
+   map() in atom.h uses the inlined map_probe() directly
 ------------------------------------------------------------------------- */
 
 int Atom::map_find_hash(tagint global)
 {
-  int local = -1;
-  int index = map_bucket[global % map_nbucket];
-  while (index > -1) {
-    if (map_hash[index].global == global) {
-      local = map_hash[index].local;
-      break;
-    }
-    index = map_hash[index].next;
+  return map_probe(global);
+}
+
+/* ----------------------------------------------------------------------
+   (re)allocate hash table with room for at least N entries
+   slots = smallest power of 2 >= 2*N, so load factor stays <= 1/2
+   entries of a previous table are rehashed into the new one
+------------------------------------------------------------------------- */
+
+void Atom::map_alloc(int n)
+{
+  if (n > MAXSMALLINT/4) error->one(FLERR,"Too many atoms for atom map hash table");
+
+  int nslot = 1;
+  int shift = 64;
+  while (nslot < 2*n) {
+    nslot *= 2;
+    shift--;
   }
-  return local;
+
+  HashElem *old = map_hash;
+  int nold = map_nslot;
+
+  map_hash = new HashElem[nslot];
+  for (int i = 0; i < nslot; i++) map_hash[i].global = -1;
+  map_nslot = nslot;
+  map_mask = nslot - 1;
+  map_shift = shift;
+  map_nhash = nslot/2;
+  map_nused = 0;
+
+  for (int i = 0; i < nold; i++)
+    if (old[i].global >= 0) map_insert(old[i].global,old[i].local);
+  delete[] old;
 }
 
 /* ----------------------------------------------------------------------
-   return next prime larger than n
+   set local index of global ID in hash table, add ID if not yet present
+   return previous local index of ID, -1 if it was not in table
+   linear probing: entries with same home slot are stored contiguously
 ------------------------------------------------------------------------- */
 
-int Atom::next_prime(int n)
+int Atom::map_insert(tagint global, int local)
 {
-  int factor;
+  if (2*(map_nused+1) > map_nslot) map_alloc(map_nused+1);
+
+  int islot = map_slot(global);
+  while (map_hash[islot].global >= 0) {
+    if (map_hash[islot].global == global) {
+      int previous = map_hash[islot].local;
+      map_hash[islot].local = local;
+      return previous;
+    }
+    islot = (islot + 1) & map_mask;
+  }
 
-  int nprime = n+1;
-  if (nprime % 2 == 0) nprime++;
-  int root = static_cast<int> (sqrt(1.0*n)) + 2;
+  map_hash[islot].global = global;
+  map_hash[islot].local = local;
+  map_nused++;
+  return -1;
+}
 
-  while (nprime < MAXSMALLINT) {
-    for (factor = 3; factor < root; factor++)
-      if (nprime % factor == 0) break;
-    if (factor == root) return nprime;
-    nprime += 2;
+/* ----------------------------------------------------------------------
+   remove global ID from hash table, if present
+   shift later entries of the probe sequence back into the hole,
+     so no tombstones are needed and lookups never slow down over time
+------------------------------------------------------------------------- */
+
+void Atom::map_remove(tagint global)
+{
+  int islot = map_slot(global);
+  while (map_hash[islot].global != global) {
+    if (map_hash[islot].global < 0) return;
+    islot = (islot + 1) & map_mask;
   }
+  map_nused--;
 
-  return MAXSMALLINT;
+  // move entry J into hole I unless J's home slot lies cyclically in (I,J]
+
+  int jslot = islot;
+  while (true) {
+    jslot = (jslot + 1) & map_mask;
+    if (map_hash[jslot].global < 0) break;
+    int home = map_slot(map_hash[jslot].global);
+    if (islot <= jslot) {
+      if (islot < home && home <= jslot) continue;
+    } else {
+      if (islot < home || home <= jslot) continue;
+    }
+    map_hash[islot] = map_hash[jslot];
+    islot = jslot;
+  }
+  map_hash[islot].global = -1;
 }
@@ -30,6 +30,7 @@
 #include "force.h"
 #include "imbalance.h"
 #include "imbalance_group.h"
+#include "imbalance_model.h"
 #include "imbalance_neigh.h"
 #include "imbalance_store.h"
 #include "imbalance_time.h"
@@ -48,7 +49,7 @@ using namespace LAMMPS_NS;
 
 double EPSNEIGH = 1.0e-3;
 
-enum{XYZ,SHIFT,BISECTION};
+enum{XYZ,SHIFT,BISECTION,RELAX};
 enum{NONE,UNIFORM,USER};
 enum{X,Y,Z};
 
@@ -65,6 +66,10 @@ Balance::Balance(LAMMPS *lmp) : Command(lmp)
 
   rcb = nullptr;
 
+  maxshift = 0.0;
+  relaxproc = nullptr;
+  maxrelaxproc = 0;
+
   nimbalance = 0;
   imbalances = nullptr;
   fixstore = nullptr;
@@ -97,6 +102,7 @@ Balance::~Balance()
   }
 
   delete rcb;
+  memory->destroy(relaxproc);
 
   for (int i = 0; i < nimbalance; i++) delete imbalances[i];
   delete[] imbalances;
@@ -213,6 +219,13 @@ void Balance::command(int narg, char **arg)
       style = BISECTION;
       iarg++;
 
+    } else if (strcmp(arg[iarg],"rcb/relax") == 0) {
+      if (style != -1) error->all(FLERR,"Illegal balance command");
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR,"balance rcb/relax",error);
+      style = RELAX;
+      relax_setup(utils::numeric(FLERR,arg[iarg+1],false,lmp));
+      iarg += 2;
+
     } else break;
   }
 
@@ -251,6 +264,8 @@ void Balance::command(int narg, char **arg)
 
   if (style == BISECTION && comm->style == Comm::BRICK)
     error->all(FLERR,"Balance rcb cannot be used with comm_style brick");
+  if (style == RELAX && comm->style == Comm::BRICK)
+    error->all(FLERR,"Balance rcb/relax cannot be used with comm_style brick");
 
   // process remaining optional args
 
@@ -285,7 +300,7 @@ void Balance::command(int narg, char **arg)
   // no load-balance if imbalance doesn't exceed threshold
   // unless switching from tiled to non tiled layout, then force rebalance
 
-  if (comm->layout == Comm::LAYOUT_TILED && style != BISECTION) {
+  if (comm->layout == Comm::LAYOUT_TILED && style != BISECTION && style != RELAX) {
   } else if (imbinit < thresh) return;
 
   // debug output of initial state
@@ -349,6 +364,18 @@ void Balance::command(int narg, char **arg)
     bisection();
   }
 
+  // style RELAX = shift cuts of existing RCB tiling
+  // requires a full RCB tiling first
+
+  int *sendproc = nullptr;
+  if (style == RELAX) {
+    if (comm->layout == Comm::LAYOUT_TILED) sendproc = relax();
+    else {
+      comm->layout = Comm::LAYOUT_TILED;
+      sendproc = bisection();
+    }
+  }
+
   // reset proc sub-domains
   // for either brick or tiled comm style
 
@@ -362,6 +389,7 @@ void Balance::command(int narg, char **arg)
   auto irregular = new Irregular(lmp);
   if (wtflag) fixstore->disable = 0;
   if (style == BISECTION) irregular->migrate_atoms(sortflag,1,rcb->sendproc);
+  else if (style == RELAX) irregular->migrate_atoms(sortflag,1,sendproc);
   else irregular->migrate_atoms(sortflag);
   delete irregular;
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
@@ -404,7 +432,7 @@ void Balance::command(int narg, char **arg)
                         "  initial/final imbalance factor  = {:.8} {:.8}\n",
                         maxinit,maxfinal,imbinit,imbfinal);
 
-    if (style != BISECTION) {
+    if (style != BISECTION && style != RELAX) {
       mesg += "  x cuts:";
       for (int i = 0; i <= comm->procgrid[0]; i++)
         mesg += fmt::format(" {:.8}",comm->xsplit[i]);
@@ -451,24 +479,28 @@ void Balance::options(int iarg, int narg, char **arg, int sortflag_default)
       int nopt = 0;
       if (strcmp(arg[iarg+1],"group") == 0) {
         imb = new ImbalanceGroup(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"time") == 0) {
         imb = new ImbalanceTime(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"neigh") == 0) {
         imb = new ImbalanceNeigh(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"var") == 0) {
         varflag = 1;
         imb = new ImbalanceVar(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
+        imbalances[nimbalance++] = imb;
+      } else if (strcmp(arg[iarg+1],"model") == 0) {
+        imb = new ImbalanceModel(lmp);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else if (strcmp(arg[iarg+1],"store") == 0) {
         imb = new ImbalanceStore(lmp);
-        nopt = imb->options(narg-iarg,arg+iarg+2);
+        nopt = imb->options(narg-iarg-2,arg+iarg+2);
         imbalances[nimbalance++] = imb;
       } else {
         error->all(FLERR,"Unknown (fix) balance weight method: {}", arg[iarg+1]);
@@ -715,6 +747,198 @@ int *Balance::bisection()
   return rcb->sendproc;
 }
 
+/* ----------------------------------------------------------------------
+   setup relax load balance operations
+   called from command and from fix balance
+------------------------------------------------------------------------- */
+
+void Balance::relax_setup(double maxshift_in)
+{
+  maxshift = maxshift_in;
+  if (maxshift <= 0.0 || maxshift > 0.5)
+    error->all(FLERR,"Balance rcb/relax max shift {} must be > 0.0 and <= 0.5",maxshift);
+}
+
+/* ----------------------------------------------------------------------
+   perform balancing by shifting the cuts of the current RCB tiling
+   tree of cuts and their dims is kept, each cut moves toward the position
+     that splits the cost of its two halves in proportion to their # of procs
+   cost is assumed uniform along the cut dim within the overloaded half
+   each cut moves by at most maxshift times the extent of its partition,
+     which bounds the # of atoms that migrate
+   return list of procs to send my atoms to
+------------------------------------------------------------------------- */
+
+int *Balance::relax()
+{
+  // gather RCB cuts and dims of all procs and cumulative cost of procs
+
+  memory->create(cutdim,nprocs,"balance:cutdim");
+  memory->create(cutold,nprocs,"balance:cutold");
+  memory->create(cutnew,nprocs,"balance:cutnew");
+  memory->create(costsum,nprocs+1,"balance:costsum");
+
+  MPI_Allgather(&comm->rcbcutdim,1,MPI_INT,cutdim,1,MPI_INT,world);
+  MPI_Allgather(&comm->rcbcutfrac,1,MPI_DOUBLE,cutold,1,MPI_DOUBLE,world);
+
+  // tiling was not created by RCB, e.g. after restart, so do a full RCB
+
+  int treeflag = 1;
+  for (int i = 1; i < nprocs; i++)
+    if (cutdim[i] < 0 || cutdim[i] > 2) treeflag = 0;
+  if (!treeflag) {
+    memory->destroy(cutdim);
+    memory->destroy(cutold);
+    memory->destroy(cutnew);
+    memory->destroy(costsum);
+    return bisection();
+  }
+
+  int nlocal = atom->nlocal;
+  double mycost;
+  if (wtflag) {
+    weight = fixstore->vstore;
+    mycost = 0.0;
+    for (int i = 0; i < nlocal; i++) mycost += weight[i];
+  } else mycost = nlocal;
+
+  MPI_Allgather(&mycost,1,MPI_DOUBLE,&costsum[1],1,MPI_DOUBLE,world);
+  costsum[0] = 0.0;
+  for (int i = 1; i <= nprocs; i++) costsum[i] += costsum[i-1];
+
+  // shift cuts top-down through the tree, starting with the entire box
+
+  for (int i = 0; i < nprocs; i++) cutnew[i] = cutold[i];
+
+  double lo[3] = {0.0, 0.0, 0.0};
+  double hi[3] = {1.0, 1.0, 1.0};
+  relax_node(0,nprocs-1,lo,hi,lo,hi);
+
+  // assign each of my atoms to new owning proc by dropping it through the tree
+  // if triclinic, tree is in lamda coords
+
+  if (nlocal > maxrelaxproc) {
+    maxrelaxproc = atom->nmax;
+    memory->destroy(relaxproc);
+    memory->create(relaxproc,maxrelaxproc,"balance:relaxproc");
+  }
+
+  double **x = atom->x;
+  int triclinic = domain->triclinic;
+  if (triclinic) domain->x2lamda(nlocal);
+
+  double *boxlo,*prd;
+  if (triclinic == 0) {
+    boxlo = domain->boxlo;
+    prd = domain->prd;
+  } else {
+    boxlo = domain->boxlo_lamda;
+    prd = domain->prd_lamda;
+  }
+
+  int proclower,procupper,procmid,idim;
+  for (int i = 0; i < nlocal; i++) {
+    proclower = 0;
+    procupper = nprocs-1;
+    while (proclower != procupper) {
+      procmid = proclower + (procupper - proclower) / 2 + 1;
+      idim = cutdim[procmid];
+      if ((x[i][idim]-boxlo[idim])/prd[idim] < cutnew[procmid]) procupper = procmid-1;
+      else proclower = procmid;
+    }
+    relaxproc[i] = proclower;
+  }
+
+  if (triclinic) domain->lamda2x(nlocal);
+
+  // store new cut and sub-domain in Comm
+
+  comm->rcbnew = 1;
+  if (comm->rcbcutdim >= 0) comm->rcbcutfrac = cutnew[me];
+  for (int idim = 0; idim < 3; idim++) {
+    comm->mysplit[idim][0] = mysplitnew[idim][0];
+    comm->mysplit[idim][1] = mysplitnew[idim][1];
+  }
+
+  memory->destroy(cutdim);
+  memory->destroy(cutold);
+  memory->destroy(cutnew);
+  memory->destroy(costsum);
+
+  return relaxproc;
+}
+
+/* ----------------------------------------------------------------------
+   shift the cut of partition of procs proclower to procupper, then recurse
+   lo,hi = new fractional bounds of the partition
+   oldlo,oldhi = its bounds before any cut was shifted
+   when my proc is reached, store its new bounds in mysplitnew
+------------------------------------------------------------------------- */
+
+void Balance::relax_node(int proclower, int procupper, double *lo, double *hi,
+                         double *oldlo, double *oldhi)
+{
+  if (proclower == procupper) {
+    if (proclower == me)
+      for (int idim = 0; idim < 3; idim++) {
+        mysplitnew[idim][0] = lo[idim];
+        mysplitnew[idim][1] = hi[idim];
+      }
+    return;
+  }
+
+  int procmid = proclower + (procupper - proclower) / 2 + 1;
+  int idim = cutdim[procmid];
+
+  // map old cut into the partition, whose bounds may have changed
+  //   by shifts of cuts higher up in the tree
+
+  double oldlen = oldhi[idim] - oldlo[idim];
+  double len = hi[idim] - lo[idim];
+  double cut = lo[idim] + (cutold[procmid] - oldlo[idim]) / oldlen * len;
+
+  // target cost of lower half is proportional to its # of procs
+  // move cut into the overloaded half so that its excess cost moves across,
+  //   assuming uniform cost density along idim in that half
+  // limit shift to maxshift of partition and half the width of the shrinking half
+
+  double lowcost = costsum[procmid] - costsum[proclower];
+  double highcost = costsum[procupper+1] - costsum[procmid];
+  double excess = lowcost - (lowcost + highcost) * (procmid - proclower) /
+    (procupper - proclower + 1);
+
+  double shift = 0.0;
+  if (excess > 0.0) {
+    shift = -excess / lowcost * (cut - lo[idim]);
+    shift = MAX(shift,-maxshift*len);
+    shift = MAX(shift,-0.5*(cut - lo[idim]));
+  } else if (excess < 0.0) {
+    shift = -excess / highcost * (hi[idim] - cut);
+    shift = MIN(shift,maxshift*len);
+    shift = MIN(shift,0.5*(hi[idim] - cut));
+  }
+  cutnew[procmid] = cut + shift;
+
+  // recurse into both halves with their new and old bounds
+
+  double newlo[3],newhi[3],oldsplitlo[3],oldsplithi[3];
+  for (int i = 0; i < 3; i++) {
+    newlo[i] = lo[i];
+    newhi[i] = hi[i];
+    oldsplitlo[i] = oldlo[i];
+    oldsplithi[i] = oldhi[i];
+  }
+
+  newhi[idim] = cutnew[procmid];
+  oldsplithi[idim] = cutold[procmid];
+  relax_node(proclower,procmid-1,newlo,newhi,oldlo,oldsplithi);
+
+  newlo[idim] = cutnew[procmid];
+  newhi[idim] = hi[idim];
+  oldsplitlo[idim] = cutold[procmid];
+  relax_node(procmid,procupper,newlo,newhi,oldsplitlo,oldhi);
+}
+
 /* ----------------------------------------------------------------------
    setup static load balance operations
    called from command and indirectly initially from fix balance
@@ -44,6 +44,8 @@ class Balance : public Command {
   void shift_setup(char *, int, double);
   int shift();
   int *bisection();
+  void relax_setup(double);
+  int *relax();
   void dumpout(bigint);
 
   static constexpr int BSTR_SIZE = 3;
@@ -76,6 +78,15 @@ class Balance : public Command {
   double *proccost;       // particle cost per processor
   double *allproccost;    // proccost summed across procs
 
+  double maxshift;        // max shift of an RCB cut for relax LB, fraction of its extent
+  int *cutdim;            // dim of RCB cut stored by each proc, -1 if none
+  double *cutold;         // fractional RCB cut stored by each proc before relax LB
+  double *cutnew;         // ditto after relax LB
+  double *costsum;        // cumulative cost of procs 0 to N-1
+  double mysplitnew[3][2];    // fractional bounds of my new sub-domain
+  int *relaxproc;         // proc to send each of my atoms to after relax LB
+  int maxrelaxproc;       // allocated length of relaxproc
+
   int nimbalance;                  // number of user-specified weight styles
   class Imbalance **imbalances;    // list of Imb classes, one per weight style
   double *weight;                  // ptr to FixStore weight vector
@@ -84,6 +95,7 @@ class Balance : public Command {
   int firststep;
 
   double imbalance_splits();
+  void relax_node(int, int, double *, double *, double *, double *);
   void shift_setup_static(char *);
   void tally(int, int, double *);
   int adjust(int, double *);
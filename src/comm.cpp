@@ -62,6 +62,11 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   ncollections = 0;
   ncollections_cutoff = 0;
   ghost_velocity = 0;
+  overlap = 0;
+  direct = 0;
+  shared = 0;
+  xsingle = 0;
+  rvous_node = 0;
 
   user_procgrid[0] = user_procgrid[1] = user_procgrid[2] = 0;
   coregrid[0] = coregrid[1] = coregrid[2] = 1;
@@ -79,8 +84,15 @@ Comm::Comm(LAMMPS *lmp) : Pointers(lmp)
   grid2proc = nullptr;
   xsplit = ysplit = zsplit = nullptr;
   rcbnew = 0;
+  rcbcutfrac = 0.0;
+  rcbcutdim = -1;
+  nbatch = maxbatch = 0;
+  batch = nullptr;
   multi_reduce = 0;
 
+  rvous_nodecomm = rvous_leadercomm = MPI_COMM_NULL;
+  node_first = node_procs = proc_node = proc_index = nullptr;
+
   // use of OpenMP threads
   // query OpenMP for number of threads/process set by user at run-time
   // if the OMP_NUM_THREADS environment variable is not set, we default
@@ -122,6 +134,8 @@ Comm::~Comm()
   memory->destroy(zsplit);
   memory->destroy(cutusermulti);
   memory->destroy(cutusermultiold);
+  memory->sfree(batch);
+  destroy_node();
   delete [] customfile;
   delete [] outfile;
 }
@@ -166,6 +180,120 @@ void Comm::copy_arrays(Comm *oldcomm)
 
   if (outfile)
     outfile = utils::strdup(oldcomm->outfile);
+
+  // queue of batched comm clients is not carried over
+
+  nbatch = maxbatch = 0;
+  batch = nullptr;
+
+  // node communicators are created again on first use
+
+  rvous_nodecomm = rvous_leadercomm = MPI_COMM_NULL;
+  node_first = node_procs = proc_node = proc_index = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   queue a Pair, Fix, or Compute for the next batched forward/reverse comm
+   for a Fix, size has the same meaning as in forward/reverse_comm(Fix *, size)
+------------------------------------------------------------------------- */
+
+void Comm::add_batch(Pair *pair)
+{
+  if (nbatch == maxbatch) {
+    maxbatch += 8;
+    batch = (BatchClient *) memory->srealloc(batch,maxbatch*sizeof(BatchClient),"comm:batch");
+  }
+  batch[nbatch].pair = pair;
+  batch[nbatch].fix = nullptr;
+  batch[nbatch].compute = nullptr;
+  batch[nbatch].size = 0;
+  nbatch++;
+}
+
+void Comm::add_batch(Fix *fix, int size)
+{
+  add_batch((Pair *) nullptr);
+  batch[nbatch-1].fix = fix;
+  batch[nbatch-1].size = size;
+}
+
+void Comm::add_batch(Compute *compute)
+{
+  add_batch((Pair *) nullptr);
+  batch[nbatch-1].compute = compute;
+}
+
+/* ----------------------------------------------------------------------
+   batched forward/reverse comm for all queued clients
+   default is one comm per client, in the order they were queued
+   Comm styles override this to combine the clients into one exchange
+------------------------------------------------------------------------- */
+
+void Comm::forward_comm_batch()
+{
+  for (int i = 0; i < nbatch; i++) {
+    if (batch[i].pair) forward_comm(batch[i].pair);
+    else if (batch[i].fix) forward_comm(batch[i].fix,batch[i].size);
+    else forward_comm(batch[i].compute);
+  }
+  nbatch = 0;
+}
+
+void Comm::reverse_comm_batch()
+{
+  for (int i = 0; i < nbatch; i++) {
+    if (batch[i].pair) reverse_comm(batch[i].pair);
+    else if (batch[i].fix) reverse_comm(batch[i].fix,batch[i].size);
+    else reverse_comm(batch[i].compute);
+  }
+  nbatch = 0;
+}
+
+/* ----------------------------------------------------------------------
+   max # of datums per atom client I sends in a forward (flag = 0)
+     or reverse (flag = 1) comm
+------------------------------------------------------------------------- */
+
+int Comm::batch_size(int i, int flag)
+{
+  if (batch[i].pair) return flag ? batch[i].pair->comm_reverse : batch[i].pair->comm_forward;
+  if (batch[i].fix) {
+    if (batch[i].size) return batch[i].size;
+    return flag ? batch[i].fix->comm_reverse : batch[i].fix->comm_forward;
+  }
+  return flag ? batch[i].compute->comm_reverse : batch[i].compute->comm_forward;
+}
+
+/* ----------------------------------------------------------------------
+   pack/unpack the forward/reverse comm data of batched client I
+------------------------------------------------------------------------- */
+
+int Comm::batch_pack_forward(int i, int n, int *list, double *buf, int pbc_flag, int *pbc)
+{
+  if (batch[i].pair) return batch[i].pair->pack_forward_comm(n,list,buf,pbc_flag,pbc);
+  if (batch[i].fix) return batch[i].fix->pack_forward_comm(n,list,buf,pbc_flag,pbc);
+  return batch[i].compute->pack_forward_comm(n,list,buf,pbc_flag,pbc);
+}
+
+void Comm::batch_unpack_forward(int i, int n, int first, double *buf)
+{
+  if (batch[i].pair) batch[i].pair->unpack_forward_comm(n,first,buf);
+  else if (batch[i].fix) batch[i].fix->unpack_forward_comm(n,first,buf);
+  else batch[i].compute->unpack_forward_comm(n,first,buf);
+}
+
+int Comm::batch_pack_reverse(int i, int n, int first, double *buf)
+{
+  if (batch[i].pair) return batch[i].pair->pack_reverse_comm(n,first,buf);
+  if (batch[i].fix) return batch[i].fix->pack_reverse_comm(n,first,buf);
+  return batch[i].compute->pack_reverse_comm(n,first,buf);
+}
+
+void Comm::batch_unpack_reverse(int i, int n, int *list, double *buf)
+{
+  if (batch[i].pair) batch[i].pair->unpack_reverse_comm(n,list,buf);
+  else if (batch[i].fix) batch[i].fix->unpack_reverse_comm(n,list,buf);
+  else batch[i].compute->unpack_reverse_comm(n,list,buf);
 }
 
 /* ----------------------------------------------------------------------
@@ -392,6 +520,33 @@ void Comm::modify_params(int narg, char **arg)
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify vel", error);
       ghost_velocity = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg],"overlap") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify overlap", error);
+      overlap = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"direct") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify direct", error);
+      direct = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"shared") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify shared", error);
+      shared = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"precision") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify precision", error);
+      if (strcmp(arg[iarg+1],"single") == 0) xsingle = 1;
+      else if (strcmp(arg[iarg+1],"double") == 0) xsingle = 0;
+      else error->all(FLERR,"Unknown comm_modify precision argument: {}", arg[iarg+1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg],"rendezvous") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "comm_modify rendezvous", error);
+      if (strcmp(arg[iarg+1],"node") == 0) rvous_node = 1;
+      else if (strcmp(arg[iarg+1],"flat") == 0) rvous_node = 0;
+      else error->all(FLERR,"Unknown comm_modify rendezvous argument: {}", arg[iarg+1]);
+#if !defined(MPI_VERSION) || (MPI_VERSION < 3)
+      if (rvous_node) error->all(FLERR,"Comm_modify rendezvous node requires MPI-3 or later");
+#endif
+      iarg += 2;
     } else error->all(FLERR,"Unknown comm_modify keyword: {}", arg[iarg]);
   }
 }
@@ -1031,42 +1186,57 @@ rendezvous_all2all(int n, char *inbuf, int insize, int inorder, int *procs,
   memcpy(sendcount,procs_a2a,nprocs*sizeof(int));
 
   memory->create(recvcount,nprocs,"rendezvous:recvcount");
-  MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
-
   memory->create(sdispls,nprocs,"rendezvous:sdispls");
   memory->create(rdispls,nprocs,"rendezvous:rdispls");
-  sdispls[0] = rdispls[0] = 0;
-  for (int i = 1; i < nprocs; i++) {
-    sdispls[i] = sdispls[i-1] + sendcount[i-1];
-    rdispls[i] = rdispls[i-1] + recvcount[i-1];
-  }
-  int nrvous = rdispls[nprocs-1] + recvcount[nprocs-1];
-
-  // test for overflow of input data due to imbalance or insize
-  // means that individual sdispls or rdispls values overflow
-
-  int overflow = 0;
-  if ((bigint) n*insize > MAXSMALLINT) overflow = 1;
-  if ((bigint) nrvous*insize > MAXSMALLINT) overflow = 1;
-  int overflowall;
-  MPI_Allreduce(&overflow,&overflowall,1,MPI_INT,MPI_MAX,world);
-  if (overflowall) error->all(FLERR,"Overflow input size in rendezvous_a2a");
-
-  for (int i = 0; i < nprocs; i++) {
-    sendcount[i] *= insize;
-    sdispls[i] *= insize;
-    recvcount[i] *= insize;
-    rdispls[i] *= insize;
-  }
 
-  // all2all comm of inbuf from caller decomp to rendezvous decomp
-  // add 1 item to the allocated buffer size, so the returned pointer is not a null pointer
+  int nrvous,overflow,overflowall;
+  char *inbuf_rvous;
 
-  auto inbuf_rvous = (char *) memory->smalloc((bigint) nrvous*insize+1, "rendezvous:inbuf");
-  memset(inbuf_rvous,0,(bigint) nrvous*insize*sizeof(char));
+  if (rvous_node) {
+
+    // all2all comm of inbuf aggregated per node, datums are units of comm
+
+    MPI_Datatype datum;
+    MPI_Type_contiguous(insize,MPI_CHAR,&datum);
+    MPI_Type_commit(&datum);
+    nrvous = alltoallv_node(inbuf_a2a,sendcount,datum,insize,inbuf_rvous,recvcount);
+    MPI_Type_free(&datum);
+
+  } else {
+    MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
+
+    sdispls[0] = rdispls[0] = 0;
+    for (int i = 1; i < nprocs; i++) {
+      sdispls[i] = sdispls[i-1] + sendcount[i-1];
+      rdispls[i] = rdispls[i-1] + recvcount[i-1];
+    }
+    nrvous = rdispls[nprocs-1] + recvcount[nprocs-1];
+
+    // test for overflow of input data due to imbalance or insize
+    // means that individual sdispls or rdispls values overflow
+
+    overflow = 0;
+    if ((bigint) n*insize > MAXSMALLINT) overflow = 1;
+    if ((bigint) nrvous*insize > MAXSMALLINT) overflow = 1;
+    MPI_Allreduce(&overflow,&overflowall,1,MPI_INT,MPI_MAX,world);
+    if (overflowall) error->all(FLERR,"Overflow input size in rendezvous_a2a");
+
+    for (int i = 0; i < nprocs; i++) {
+      sendcount[i] *= insize;
+      sdispls[i] *= insize;
+      recvcount[i] *= insize;
+      rdispls[i] *= insize;
+    }
+
+    // all2all comm of inbuf from caller decomp to rendezvous decomp
+    // add 1 item to the allocated buffer size, so the returned pointer is not a null pointer
+
+    inbuf_rvous = (char *) memory->smalloc((bigint) nrvous*insize+1, "rendezvous:inbuf");
+    memset(inbuf_rvous,0,(bigint) nrvous*insize*sizeof(char));
 
-  MPI_Alltoallv(inbuf_a2a,sendcount,sdispls,MPI_CHAR,
-                inbuf_rvous,recvcount,rdispls,MPI_CHAR,world);
+    MPI_Alltoallv(inbuf_a2a,sendcount,sdispls,MPI_CHAR,
+                  inbuf_rvous,recvcount,rdispls,MPI_CHAR,world);
+  }
 
   if (!inorder) {
     memory->destroy(procs_a2a);
@@ -1132,39 +1302,54 @@ rendezvous_all2all(int n, char *inbuf, int insize, int inorder, int *procs,
 
   memcpy(sendcount,procs_a2a,nprocs*sizeof(int));
 
-  MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
+  int nout;
 
-  sdispls[0] = rdispls[0] = 0;
-  for (int i = 1; i < nprocs; i++) {
-    sdispls[i] = sdispls[i-1] + sendcount[i-1];
-    rdispls[i] = rdispls[i-1] + recvcount[i-1];
-  }
-  int nout = rdispls[nprocs-1] + recvcount[nprocs-1];
-
-  // test for overflow of outbuf due to imbalance or outsize
-  // means that individual sdispls or rdispls values overflow
-
-  overflow = 0;
-  if ((bigint) nrvous*outsize > MAXSMALLINT) overflow = 1;
-  if ((bigint) nout*outsize > MAXSMALLINT) overflow = 1;
-  MPI_Allreduce(&overflow,&overflowall,1,MPI_INT,MPI_MAX,world);
-  if (overflowall) error->all(FLERR,"Overflow output in rendezvous_a2a");
-
-  for (int i = 0; i < nprocs; i++) {
-    sendcount[i] *= outsize;
-    sdispls[i] *= outsize;
-    recvcount[i] *= outsize;
-    rdispls[i] *= outsize;
-  }
+  if (rvous_node) {
 
-  // all2all comm of outbuf from rendezvous decomp back to caller decomp
-  // caller will free outbuf
-  // add 1 item to the allocated buffer size, so the returned pointer is not a null pointer
+    // all2all comm of outbuf aggregated per node
+    // caller will free outbuf
 
-  outbuf = (char *) memory->smalloc((bigint) nout*outsize+1,"rendezvous:outbuf");
+    MPI_Datatype datum;
+    MPI_Type_contiguous(outsize,MPI_CHAR,&datum);
+    MPI_Type_commit(&datum);
+    nout = alltoallv_node(outbuf_a2a,sendcount,datum,outsize,outbuf,recvcount);
+    MPI_Type_free(&datum);
 
-  MPI_Alltoallv(outbuf_a2a,sendcount,sdispls,MPI_CHAR,
-                outbuf,recvcount,rdispls,MPI_CHAR,world);
+  } else {
+    MPI_Alltoall(sendcount,1,MPI_INT,recvcount,1,MPI_INT,world);
+
+    sdispls[0] = rdispls[0] = 0;
+    for (int i = 1; i < nprocs; i++) {
+      sdispls[i] = sdispls[i-1] + sendcount[i-1];
+      rdispls[i] = rdispls[i-1] + recvcount[i-1];
+    }
+    nout = rdispls[nprocs-1] + recvcount[nprocs-1];
+
+    // test for overflow of outbuf due to imbalance or outsize
+    // means that individual sdispls or rdispls values overflow
+
+    overflow = 0;
+    if ((bigint) nrvous*outsize > MAXSMALLINT) overflow = 1;
+    if ((bigint) nout*outsize > MAXSMALLINT) overflow = 1;
+    MPI_Allreduce(&overflow,&overflowall,1,MPI_INT,MPI_MAX,world);
+    if (overflowall) error->all(FLERR,"Overflow output in rendezvous_a2a");
+
+    for (int i = 0; i < nprocs; i++) {
+      sendcount[i] *= outsize;
+      sdispls[i] *= outsize;
+      recvcount[i] *= outsize;
+      rdispls[i] *= outsize;
+    }
+
+    // all2all comm of outbuf from rendezvous decomp back to caller decomp
+    // caller will free outbuf
+    // add 1 item to the allocated buffer size, so the returned pointer is not a null pointer
+
+    outbuf = (char *) memory->smalloc((bigint) nout*outsize+1,"rendezvous:outbuf");
+
+    MPI_Alltoallv(outbuf_a2a,sendcount,sdispls,MPI_CHAR,
+                  outbuf,recvcount,rdispls,MPI_CHAR,world);
+  }
 
   memory->destroy(procs_rvous);
   memory->sfree(outbuf_rvous);
@@ -1192,6 +1377,353 @@ rendezvous_all2all(int n, char *inbuf, int insize, int inorder, int *procs,
   return nout;
 }
 
+/* ----------------------------------------------------------------------
+   all2all communication aggregated per node, replaces MPI_Alltoallv()
+   three stages:
+     all procs on a node gather their data to the 1st proc of the node (leader)
+     leaders exchange data for procs on each other's node via MPI_Alltoallv()
+     leaders scatter received data to the procs on their node
+   # of messages between nodes is nnodes^2 instead of nprocs^2
+   inputs:
+     sendbuf = data to send, ordered by proc to send to
+     sendcount = # of units of type to send to each proc
+     type = MPI datatype of one unit
+     size = byte size of one unit
+   outputs:
+     nrecv = # of units received (function return)
+     recvbuf = received data, ordered by proc it came from, allocated here
+               same order as from MPI_Alltoallv(), caller will free recvbuf
+     recvcount = # of units received from each proc
+------------------------------------------------------------------------- */
+
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+int Comm::alltoallv_node(char *sendbuf, int *sendcount, MPI_Datatype type, int size,
+                         char *&recvbuf, int *recvcount)
+{
+  int nrecv = 0;
+
+  if (rvous_nodecomm == MPI_COMM_NULL) setup_node();
+
+  int i,iproc,inode,isrc,itgt,nsrc,ntgt,first;
+  bigint m,offset,total;
+
+  const int leader = (node_me == 0);
+  const int nlocal = node_nprocs;
+
+  int *allcount = nullptr;
+  int *gcount = nullptr;
+  int *gdispl = nullptr;
+  char *gbuf = nullptr;
+
+  // gather send counts to all procs and data of procs on my node to leader
+
+  int nsend = 0;
+  for (iproc = 0; iproc < nprocs; iproc++) nsend += sendcount[iproc];
+
+  if (leader) {
+    memory->create(allcount,(bigint) nlocal*nprocs,"comm:allcount");
+    memory->create(gcount,nlocal,"comm:gcount");
+    memory->create(gdispl,nlocal,"comm:gdispl");
+  }
+
+  MPI_Gather(sendcount,nprocs,MPI_INT,allcount,nprocs,MPI_INT,0,rvous_nodecomm);
+  MPI_Gather(&nsend,1,MPI_INT,gcount,1,MPI_INT,0,rvous_nodecomm);
+
+  if (leader) {
+    total = 0;
+    for (isrc = 0; isrc < nlocal; isrc++) {
+      if (total > MAXSMALLINT) break;
+      gdispl[isrc] = total;
+      total += gcount[isrc];
+    }
+    if (total > MAXSMALLINT) error->one(FLERR,"Overflow of node data in all2all comm");
+    gbuf = (char *) memory->smalloc(total*size+1,"comm:gbuf");
+  }
+
+  MPI_Gatherv(sendbuf,nsend,type,gbuf,gcount,gdispl,type,0,rvous_nodecomm);
+
+  char *rbuf = nullptr;
+  int *rcount = nullptr;
+  int *mycount = nullptr;
+  bigint *roffset = nullptr;
+
+  if (leader) {
+
+    // exchange between leaders: one message to each node with
+    //   counts and data from each proc on my node to each proc on that node
+    // soffset = offset in gbuf of data from each proc on my node to each proc
+
+    auto soffset = (bigint *) memory->smalloc((bigint) nlocal*nprocs*sizeof(bigint),
+                                              "comm:soffset");
+    for (isrc = 0; isrc < nlocal; isrc++) {
+      offset = gdispl[isrc];
+      for (iproc = 0; iproc < nprocs; iproc++) {
+        m = (bigint) isrc*nprocs + iproc;
+        soffset[m] = offset;
+        offset += allcount[m];
+      }
+    }
+
+    int *csend,*csdispl,*crecv,*crdispl;
+    int *dsend,*dsdispl,*drecv,*drdispl;
+    memory->create(csend,nnodes,"comm:csend");
+    memory->create(csdispl,nnodes,"comm:csdispl");
+    memory->create(crecv,nnodes,"comm:crecv");
+    memory->create(crdispl,nnodes,"comm:crdispl");
+    memory->create(dsend,nnodes,"comm:dsend");
+    memory->create(dsdispl,nnodes,"comm:dsdispl");
+    memory->create(drecv,nnodes,"comm:drecv");
+    memory->create(drdispl,nnodes,"comm:drdispl");
+
+    for (inode = 0; inode < nnodes; inode++) {
+      ntgt = node_first[inode+1] - node_first[inode];
+      csend[inode] = nlocal*ntgt;
+      crecv[inode] = ntgt*nlocal;
+      csdispl[inode] = nlocal*node_first[inode];
+      crdispl[inode] = node_first[inode]*nlocal;
+    }
+
+    // scount = counts ordered by node, proc on my node, proc on that node
+
+    int *scount,*ccount;
+    memory->create(scount,(bigint) nlocal*nprocs,"comm:scount");
+    memory->create(rcount,(bigint) nprocs*nlocal,"comm:rcount");
+
+    m = 0;
+    for (inode = 0; inode < nnodes; inode++) {
+      first = node_first[inode];
+      ntgt = node_first[inode+1] - first;
+      total = 0;
+      for (isrc = 0; isrc < nlocal; isrc++)
+        for (itgt = 0; itgt < ntgt; itgt++) {
+          scount[m] = allcount[(bigint) isrc*nprocs + node_procs[first+itgt]];
+          total += scount[m++];
+        }
+      dsend[inode] = total;
+    }
+
+    MPI_Alltoallv(scount,csend,csdispl,MPI_INT,rcount,crecv,crdispl,MPI_INT,rvous_leadercomm);
+
+    // data sizes and displacements for exchange between leaders
+
+    total = 0;
+    for (inode = 0; inode < nnodes; inode++) {
+      if (total > MAXSMALLINT) break;
+      dsdispl[inode] = total;
+      total += dsend[inode];
+    }
+    if (total > MAXSMALLINT) error->one(FLERR,"Overflow of node data in all2all comm");
+
+    auto sbuf = (char *) memory->smalloc(total*size+1,"comm:sbuf");
+
+    m = 0;
+    offset = 0;
+    for (inode = 0; inode < nnodes; inode++) {
+      first = node_first[inode];
+      ntgt = node_first[inode+1] - first;
+      for (isrc = 0; isrc < nlocal; isrc++)
+        for (itgt = 0; itgt < ntgt; itgt++) {
+          const int count = scount[m++];
+          const bigint src = soffset[(bigint) isrc*nprocs + node_procs[first+itgt]];
+          memcpy(&sbuf[offset*size],&gbuf[src*size],(bigint) count*size);
+          offset += count;
+        }
+    }
+
+    memory->sfree(gbuf);
+    memory->sfree(soffset);
+    memory->destroy(scount);
+    memory->destroy(allcount);
+    memory->destroy(gcount);
+    memory->destroy(gdispl);
+
+    // roffset = offset in rbuf of data from each proc to each proc on my node
+    // rcount and roffset are ordered by node, proc on that node, proc on my node
+    //   which is the same as by index in node_procs
+
+    roffset = (bigint *) memory->smalloc((bigint) nprocs*nlocal*sizeof(bigint),"comm:roffset");
+
+    m = 0;
+    total = 0;
+    for (inode = 0; inode < nnodes; inode++) {
+      if (total > MAXSMALLINT) break;
+      drdispl[inode] = total;
+      nsrc = node_first[inode+1] - node_first[inode];
+      offset = 0;
+      for (i = 0; i < nsrc*nlocal; i++) {
+        roffset[m] = total + offset;
+        offset += rcount[m++];
+      }
+      drecv[inode] = offset;
+      total += offset;
+    }
+    if (total > MAXSMALLINT) error->one(FLERR,"Overflow of node data in all2all comm");
+
+    rbuf = (char *) memory->smalloc(total*size+1,"comm:rbuf");
+
+    MPI_Alltoallv(sbuf,dsend,dsdispl,type,rbuf,drecv,drdispl,type,rvous_leadercomm);
+
+    memory->sfree(sbuf);
+    memory->destroy(csend);
+    memory->destroy(csdispl);
+    memory->destroy(crecv);
+    memory->destroy(crdispl);
+    memory->destroy(dsend);
+    memory->destroy(dsdispl);
+    memory->destroy(drecv);
+    memory->destroy(drdispl);
+
+    // reorder received data for each proc on my node by proc it came from
+    // mycount = # of units each proc on my node receives from each proc
+
+    memory->create(ccount,(bigint) nlocal*nprocs,"comm:ccount");
+    memory->create(mycount,nlocal,"comm:mycount");
+    memory->create(gdispl,nlocal,"comm:gdispl");
+
+    total = 0;
+    for (itgt = 0; itgt < nlocal; itgt++) {
+      if (total > MAXSMALLINT) break;
+      gdispl[itgt] = total;
+      offset = 0;
+      for (iproc = 0; iproc < nprocs; iproc++) {
+        m = (bigint) proc_index[iproc]*nlocal + itgt;
+        ccount[(bigint) itgt*nprocs + iproc] = rcount[m];
+        offset += rcount[m];
+      }
+      if (offset > MAXSMALLINT) break;
+      mycount[itgt] = offset;
+      total += offset;
+    }
+    if (total > MAXSMALLINT) error->one(FLERR,"Overflow of node data in all2all comm");
+
+    gbuf = (char *) memory->smalloc(total*size+1,"comm:gbuf");
+
+    offset = 0;
+    for (itgt = 0; itgt < nlocal; itgt++)
+      for (iproc = 0; iproc < nprocs; iproc++) {
+        m = (bigint) proc_index[iproc]*nlocal + itgt;
+        memcpy(&gbuf[offset*size],&rbuf[roffset[m]*size],(bigint) rcount[m]*size);
+        offset += rcount[m];
+      }
+
+    memory->sfree(rbuf);
+    memory->sfree(roffset);
+    memory->destroy(rcount);
+    rcount = ccount;
+  }
+
+  // scatter counts and data to procs on my node
+
+  MPI_Scatter(rcount,nprocs,MPI_INT,recvcount,nprocs,MPI_INT,0,rvous_nodecomm);
+
+  for (iproc = 0; iproc < nprocs; iproc++) nrecv += recvcount[iproc];
+
+  // add 1 item to the allocated buffer size, so the returned pointer is not a null pointer
+
+  recvbuf = (char *) memory->smalloc((bigint) nrecv*size+1,"comm:recvbuf");
+
+  MPI_Scatterv(gbuf,mycount,gdispl,type,recvbuf,nrecv,type,0,rvous_nodecomm);
+
+  if (leader) {
+    memory->sfree(gbuf);
+    memory->destroy(rcount);
+    memory->destroy(mycount);
+    memory->destroy(gdispl);
+  }
+
+  return nrecv;
+}
+#else
+int Comm::alltoallv_node(char * /*sendbuf*/, int * /*sendcount*/, MPI_Datatype /*type*/,
+                         int /*size*/, char *& /*recvbuf*/, int * /*recvcount*/)
+{
+  error->all(FLERR,"Comm_modify rendezvous node requires MPI-3 or later");
+  return 0;
+}
+#endif
+
+/* ----------------------------------------------------------------------
+   decide if an all2all comm in which this proc sends nsend messages
+     is aggregated per node by alltoallv_node()
+   only worth it if some proc sends to more procs than there are nodes,
+     sparse comm, e.g. migration of atoms to nearby procs, is done directly
+   must be called by all procs
+------------------------------------------------------------------------- */
+
+int Comm::node_aggregate(int nsend)
+{
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (rvous_nodecomm == MPI_COMM_NULL) setup_node();
+
+  int maxsend;
+  MPI_Allreduce(&nsend,&maxsend,1,MPI_INT,MPI_MAX,world);
+  return (maxsend > nnodes) ? 1 : 0;
+#else
+  (void) nsend;
+  return 0;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   create node and leader communicators and map of procs to nodes
+------------------------------------------------------------------------- */
+
+void Comm::setup_node()
+{
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  MPI_Comm_split_type(world,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,&rvous_nodecomm);
+  MPI_Comm_rank(rvous_nodecomm,&node_me);
+  MPI_Comm_size(rvous_nodecomm,&node_nprocs);
+  MPI_Comm_split(world,(node_me == 0) ? 0 : MPI_UNDEFINED,me,&rvous_leadercomm);
+
+  int mynode[2];
+  if (node_me == 0) {
+    MPI_Comm_rank(rvous_leadercomm,&mynode[0]);
+    MPI_Comm_size(rvous_leadercomm,&nnodes);
+  }
+  MPI_Bcast(&mynode[0],1,MPI_INT,0,rvous_nodecomm);
+  MPI_Bcast(&nnodes,1,MPI_INT,0,rvous_nodecomm);
+  mynode[1] = node_me;
+
+  // node and node rank of every proc
+
+  int *allnode;
+  memory->create(allnode,2*nprocs,"comm:allnode");
+  MPI_Allgather(mynode,2,MPI_INT,allnode,2,MPI_INT,world);
+
+  memory->create(node_first,nnodes+1,"comm:node_first");
+  memory->create(node_procs,nprocs,"comm:node_procs");
+  memory->create(proc_node,nprocs,"comm:proc_node");
+  memory->create(proc_index,nprocs,"comm:proc_index");
+
+  for (int inode = 0; inode <= nnodes; inode++) node_first[inode] = 0;
+  for (int iproc = 0; iproc < nprocs; iproc++) node_first[allnode[2*iproc]+1]++;
+  for (int inode = 0; inode < nnodes; inode++) node_first[inode+1] += node_first[inode];
+
+  for (int iproc = 0; iproc < nprocs; iproc++) {
+    proc_node[iproc] = allnode[2*iproc];
+    proc_index[iproc] = node_first[proc_node[iproc]] + allnode[2*iproc+1];
+    node_procs[proc_index[iproc]] = iproc;
+  }
+
+  memory->destroy(allnode);
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   free node and leader communicators and map of procs to nodes
+------------------------------------------------------------------------- */
+
+void Comm::destroy_node()
+{
+  if (rvous_nodecomm != MPI_COMM_NULL) MPI_Comm_free(&rvous_nodecomm);
+  if (rvous_leadercomm != MPI_COMM_NULL) MPI_Comm_free(&rvous_leadercomm);
+  memory->destroy(node_first);
+  memory->destroy(node_procs);
+  memory->destroy(proc_node);
+  memory->destroy(proc_index);
+}
+
 /* ----------------------------------------------------------------------
    print balance and memory info for rendezvous operation
    useful for debugging
@@ -35,6 +35,11 @@ class Comm : protected Pointers {
 
   int me, nprocs;               // proc info
   int ghost_velocity;           // 1 if ghost atoms have velocity, 0 if not
+  int overlap;                  // 1 if forward comm may overlap pair compute
+  int direct;                   // 1 if direct exchange with all neighbor procs is requested
+  int shared;                   // 1 if on-node neighbor procs exchange via shared memory
+  int xsingle;                  // 1 if ghost coords may be sent in single precision
+  int rvous_node;               // 1 if rendezvous/irregular comm is aggregated per node
   double cutghost[3];           // cutoffs used for acquiring ghost atoms
   double cutghostuser;          // user-specified ghost cutoff (mode == SINGLE)
   double *cutusermulti;         // per collection user ghost cutoff (mode == MULTI)
@@ -85,6 +90,12 @@ class Comm : protected Pointers {
   virtual void exchange() = 0;                     // move atoms to new procs
   virtual void borders() = 0;                      // setup list of atoms to comm
 
+  // forward comm of atom coords split into a non-blocking start and its completion
+  // default is to do all communication in forward_comm_end()
+
+  virtual void forward_comm_begin() {}
+  virtual void forward_comm_end() { forward_comm(); }
+
   // forward/reverse comm from a Pair, Bond, Fix, Compute, Dump
 
   virtual void forward_comm(class Pair *) = 0;
@@ -99,6 +110,17 @@ class Comm : protected Pointers {
   virtual void forward_comm(class Dump *) = 0;
   virtual void reverse_comm(class Dump *) = 0;
 
+  // batched forward/reverse comm for several Pair, Fix, Compute clients
+  // clients are queued with add_batch(), the next forward/reverse_comm_batch()
+  //   ships their per-atom data together and empties the queue
+  // default is one forward/reverse comm per queued client
+
+  void add_batch(class Pair *);
+  void add_batch(class Fix *, int size = 0);
+  void add_batch(class Compute *);
+  virtual void forward_comm_batch();
+  virtual void reverse_comm_batch();
+
   // forward comm of an array
 
   virtual void forward_comm_array(int, double **) = 0;
@@ -118,6 +140,8 @@ class Comm : protected Pointers {
   int rendezvous(int, int, char *, int, int, int *,
                  int (*)(int, char *, int &, int *&, char *&, void *), int, char *&, int, void *,
                  int statflag = 0);
+  int alltoallv_node(char *, int *, MPI_Datatype, int, char *&, int *);
+  int node_aggregate(int);
 
   // extract data useful to other classes
 
@@ -141,6 +165,27 @@ class Comm : protected Pointers {
   int maxexchange_fix_dynamic;    // 1 if a fix has a dynamic contribution
   int bufextra;                   // augment send buf size for an exchange atom
 
+  struct BatchClient {    // one client queued for a batched comm
+    class Pair *pair;     // exactly one of pair, fix, compute is set
+    class Fix *fix;
+    class Compute *compute;
+    int size;             // max # of datums per atom for a Fix, 0 = its comm_forward/reverse
+  };
+
+  int nbatch, maxbatch;    // # of queued clients, allocated length of batch
+  BatchClient *batch;      // clients queued for forward/reverse_comm_batch()
+
+  // procs grouped by node for node-aggregated all2all, set up on first use
+
+  MPI_Comm rvous_nodecomm;      // procs on my node
+  MPI_Comm rvous_leadercomm;    // 1st proc of each node, MPI_COMM_NULL on other procs
+  int node_me, node_nprocs;     // my rank and # of procs in rvous_nodecomm
+  int nnodes;                   // # of nodes
+  int *node_first;              // index of 1st proc of each node in node_procs
+  int *node_procs;              // procs grouped by node, in order of node rank
+  int *proc_node;               // node of each proc
+  int *proc_index;              // index of each proc in node_procs
+
   int gridflag;        // option for creating 3d grid
   int mapflag;         // option for mapping procs to 3d grid
   char xyz[4];         // xyz mapping of procs to 3d grid
@@ -164,6 +209,14 @@ class Comm : protected Pointers {
                          int (*)(int, char *, int &, int *&, char *&, void *), int, char *&, int,
                          void *, int);
   void rendezvous_stats(int, int, int, int, int, int, bigint);
+  void setup_node();
+  void destroy_node();
+
+  int batch_size(int, int);
+  int batch_pack_forward(int, int, int *, double *, int, int *);
+  void batch_unpack_forward(int, int, int, double *);
+  int batch_pack_reverse(int, int, int, double *);
+  void batch_unpack_reverse(int, int, int *, double *);
 
  public:
   enum { MULTIPLE };
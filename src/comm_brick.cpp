@@ -27,6 +27,7 @@
 #include "error.h"
 #include "fix.h"
 #include "memory.h"
+#include "modify.h"
 #include "neighbor.h"
 #include "pair.h"
 
@@ -38,6 +39,7 @@ using namespace LAMMPS_NS;
 #define BUFFACTOR 1.5
 #define BUFMIN 1024
 #define BIG 1.0e20
+#define DIRECTTAG 1000
 
 /* ---------------------------------------------------------------------- */
 
@@ -48,7 +50,9 @@ CommBrick::CommBrick(LAMMPS *lmp) :
   slablo(nullptr), slabhi(nullptr), multilo(nullptr), multihi(nullptr),
   multioldlo(nullptr), multioldhi(nullptr), cutghostmulti(nullptr), cutghostmultiold(nullptr),
   pbc_flag(nullptr), pbc(nullptr), firstrecv(nullptr), sendlist(nullptr),
-  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr)
+  localsendlist(nullptr), maxsendlist(nullptr), buf_send(nullptr), buf_recv(nullptr),
+  buf_send_overlap(nullptr), direct_list(nullptr), buf_direct_send(nullptr),
+  buf_direct_recv(nullptr), xref(nullptr)
 {
   style = Comm::BRICK;
   layout = Comm::LAYOUT_UNIFORM;
@@ -78,6 +82,15 @@ CommBrick::~CommBrick()
 
   memory->destroy(buf_send);
   memory->destroy(buf_recv);
+  memory->destroy(buf_send_overlap);
+  memory->destroy(xref);
+
+  free_direct();
+  free_direct_buffers();
+  memory->destroy(direct_list);
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (nodecomm != MPI_COMM_NULL) MPI_Comm_free(&nodecomm);
+#endif
 }
 
 /* ---------------------------------------------------------------------- */
@@ -115,6 +128,27 @@ void CommBrick::init_buffers()
   CommBrick::grow_send(maxsend,2);
   memory->create(buf_recv,maxrecv,"comm:buf_recv");
 
+  buf_send_overlap = nullptr;
+  maxsend_overlap = 0;
+  noverlap = nrequest_overlap = 0;
+
+  direct_enable = direct_active = direct_pending = direct_warn = 0;
+  direct_list = nullptr;
+  buf_direct_send = buf_direct_recv = nullptr;
+  maxdirect_list = maxdirect_send = maxdirect_recv = 0;
+  nreq_forward_send = nreq_forward_recv = 0;
+  nreq_reverse_send = nreq_reverse_recv = 0;
+  direct_shared = 0;
+
+  xsingle_active = 0;
+  xref_pending = 1;
+  xref = nullptr;
+  maxxref = 0;
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  nodecomm = MPI_COMM_NULL;
+  win_direct_send = win_direct_recv = MPI_WIN_NULL;
+#endif
+
   nswap = 0;
   maxswap = 6;
   CommBrick::allocate_swap(maxswap);
@@ -178,6 +212,29 @@ void CommBrick::init()
     free_multiold();
     memory->destroy(cutghostmultiold);
   }
+
+  if ((direct || shared) && lmp->kokkos)
+    error->all(FLERR,"Comm_modify direct or shared yes is not compatible with KOKKOS");
+#if !defined(MPI_VERSION) || (MPI_VERSION < 3)
+  if (shared) error->all(FLERR,"Comm_modify shared yes requires MPI-3 or later");
+#endif
+
+  // single precision displacements require that periodic image shifts are constant
+  //   between reneighborings, i.e. that no fix changes box size or shape
+  // direct exchange takes precedence
+
+  xsingle_active = 0;
+  if (xsingle) {
+    if (lmp->kokkos) error->all(FLERR,"Comm_modify precision single is not compatible with KOKKOS");
+    int box_flag = 0;
+    for (const auto &fix : modify->get_fix_list())
+      if (fix->box_change & (Fix::BOX_CHANGE_SIZE | Fix::BOX_CHANGE_SHAPE)) box_flag = 1;
+    if (box_flag) {
+      if (me == 0)
+        error->warning(FLERR,"Comm_modify precision single is ignored when a fix changes the box");
+    } else if (!direct && !shared) xsingle_active = 1;
+  }
+  xref_pending = 1;
 }
 
 /* ----------------------------------------------------------------------
@@ -387,6 +444,20 @@ void CommBrick::setup()
     maxneed[2] = MAX(all[4],all[5]);
   }
 
+  // direct exchange requires that all ghost atoms are owned by adjacent procs
+  // maxneed is the same on all procs, so this is a consistent decision
+
+  free_direct();
+  direct_enable = 0;
+  if (direct || shared) {
+    if ((maxneed[0] > 1) || (maxneed[1] > 1) || (maxneed[2] > 1)) {
+      if ((me == 0) && !direct_warn)
+        error->warning(FLERR,"Ghost atoms are needed from procs beyond adjacent procs, "
+                       "comm_modify direct and shared yes are ignored");
+      direct_warn = 1;
+    } else direct_enable = 1;
+  }
+
   // allocate comm memory
 
   nswap = 2 * (maxneed[0]+maxneed[1]+maxneed[2]);
@@ -536,6 +607,184 @@ int CommBrick::updown(int dim, int dir, int loc, double prd, int periodicity, do
 ------------------------------------------------------------------------- */
 
 void CommBrick::forward_comm(int /*dummy*/)
+{
+  if (direct_active) {
+    forward_comm_direct_begin();
+    forward_comm_direct_end();
+    return;
+  }
+
+  // 1st forward comm after borders() is in full precision and sets reference coords
+
+  if (xsingle_active && comm_x_only) {
+    if (xref_pending) {
+      forward_comm_swaps(0);
+      store_xref();
+    } else forward_comm_single();
+    return;
+  }
+
+  forward_comm_swaps(0);
+}
+
+/* ----------------------------------------------------------------------
+   start forward communication of atom coords, so that it can overlap
+     with computation that does not need ghost atom coords
+   only the two swaps in the 1st dimension send owned atoms exclusively,
+     so only those can proceed concurrently and are started here
+   only done for exchanges of coords directly into x
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_begin()
+{
+  noverlap = nrequest_overlap = 0;
+  if (direct_active) {
+    forward_comm_direct_begin();
+    direct_pending = 1;
+    return;
+  }
+  if (!comm_x_only || (nswap < 2) || (maxneed[0] < 1)) return;
+  if (xsingle_active) return;
+
+  int n;
+  AtomVec *avec = atom->avec;
+  double **x = atom->x;
+
+  // post receives for both swaps before any send
+  // use separate message tags, since both swaps may talk to the same proc
+
+  for (int iswap = 0; iswap < 2; iswap++)
+    if ((sendproc[iswap] != me) && size_forward_recv[iswap])
+      MPI_Irecv(x[firstrecv[iswap]],size_forward_recv[iswap],MPI_DOUBLE,
+                recvproc[iswap],iswap,world,&request_overlap[nrequest_overlap++]);
+
+  for (int iswap = 0; iswap < 2; iswap++) {
+    if (sendproc[iswap] != me) {
+      double *buf = buf_send;
+      if (iswap == 1) {
+        n = sendnum[iswap]*size_forward;
+        if (n > maxsend_overlap) {
+          maxsend_overlap = static_cast<int> (BUFFACTOR * n);
+          memory->destroy(buf_send_overlap);
+          memory->create(buf_send_overlap,maxsend_overlap,"comm:buf_send_overlap");
+        }
+        buf = buf_send_overlap;
+      }
+      n = avec->pack_comm(sendnum[iswap],sendlist[iswap],buf,pbc_flag[iswap],pbc[iswap]);
+      if (n) MPI_Isend(buf,n,MPI_DOUBLE,sendproc[iswap],iswap,world,
+                       &request_overlap[nrequest_overlap++]);
+    } else if (sendnum[iswap]) {
+      avec->pack_comm(sendnum[iswap],sendlist[iswap],x[firstrecv[iswap]],
+                      pbc_flag[iswap],pbc[iswap]);
+    }
+  }
+
+  noverlap = 2;
+}
+
+/* ----------------------------------------------------------------------
+   complete forward communication of atom coords started by forward_comm_begin()
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_end()
+{
+  if (direct_pending) {
+    forward_comm_direct_end();
+    direct_pending = 0;
+    return;
+  }
+
+  if (nrequest_overlap) MPI_Waitall(nrequest_overlap,request_overlap,MPI_STATUSES_IGNORE);
+  nrequest_overlap = 0;
+
+  if (noverlap) forward_comm_swaps(noverlap);
+  else CommBrick::forward_comm();
+  noverlap = 0;
+}
+
+/* ----------------------------------------------------------------------
+   forward communication of atom coords in single precision
+   send displacement of each atom since reference coords were stored,
+     which is small between reneighborings, so the single precision
+     rounding error is much smaller than for the coords themselves
+   displacement is the same for all periodic images, so no PBC shift
+   receiver adds displacement to its own reference coords of the ghost atom
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_single()
+{
+  int i,j,m,n,last;
+  MPI_Request request;
+  double **x = atom->x;
+  float *fbuf;
+
+  for (int iswap = 0; iswap < nswap; iswap++) {
+
+    // pack buffer, floats use at most half of buf_send
+
+    int *list = sendlist[iswap];
+    fbuf = (float *) buf_send;
+    n = sendnum[iswap];
+    m = 0;
+    for (i = 0; i < n; i++) {
+      j = list[i];
+      fbuf[m++] = (float) (x[j][0] - xref[j][0]);
+      fbuf[m++] = (float) (x[j][1] - xref[j][1]);
+      fbuf[m++] = (float) (x[j][2] - xref[j][2]);
+    }
+
+    // exchange with another proc
+    // if self, set recv buffer to send buffer
+
+    if (sendproc[iswap] != me) {
+      if (recvnum[iswap])
+        MPI_Irecv(buf_recv,3*recvnum[iswap],MPI_FLOAT,recvproc[iswap],0,world,&request);
+      if (m) MPI_Send(buf_send,m,MPI_FLOAT,sendproc[iswap],0,world);
+      if (recvnum[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+      fbuf = (float *) buf_recv;
+    }
+
+    // unpack buffer
+
+    m = 0;
+    last = firstrecv[iswap] + recvnum[iswap];
+    for (i = firstrecv[iswap]; i < last; i++) {
+      x[i][0] = xref[i][0] + fbuf[m++];
+      x[i][1] = xref[i][1] + fbuf[m++];
+      x[i][2] = xref[i][2] + fbuf[m++];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store coords of owned and ghost atoms as reference for forward_comm_single()
+   called after the 1st forward comm following borders(),
+     when all procs have the same full precision ghost coords
+------------------------------------------------------------------------- */
+
+void CommBrick::store_xref()
+{
+  int nall = atom->nlocal + atom->nghost;
+  if (nall > maxxref) {
+    maxxref = atom->nmax;
+    memory->destroy(xref);
+    memory->create(xref,maxxref,3,"comm:xref");
+  }
+
+  double **x = atom->x;
+  for (int i = 0; i < nall; i++) {
+    xref[i][0] = x[i][0];
+    xref[i][1] = x[i][1];
+    xref[i][2] = x[i][2];
+  }
+  xref_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   forward communication of atom coords for swaps first to nswap-1
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_swaps(int first)
 {
   int n;
   MPI_Request request;
@@ -547,7 +796,7 @@ void CommBrick::forward_comm(int /*dummy*/)
   // if other proc is self, just copy
   // if comm_x_only set, exchange or copy directly to x, don't unpack
 
-  for (int iswap = 0; iswap < nswap; iswap++) {
+  for (int iswap = first; iswap < nswap; iswap++) {
     if (sendproc[iswap] != me) {
       if (comm_x_only) {
         if (size_forward_recv[iswap]) {
@@ -597,6 +846,11 @@ void CommBrick::forward_comm(int /*dummy*/)
 
 void CommBrick::reverse_comm()
 {
+  if (direct_active) {
+    reverse_comm_direct();
+    return;
+  }
+
   int n;
   MPI_Request request;
   AtomVec *avec = atom->avec;
@@ -973,11 +1227,543 @@ void CommBrick::borders()
   max = MAX(maxforward*rmax,maxreverse*smax);
   if (max > maxrecv) grow_recv(max);
 
+  // setup direct exchange from the new list of ghost atoms
+
+  if (direct_enable) setup_direct();
+
+  // reference coords for single precision forward comm are stale
+
+  xref_pending = 1;
+
   // reset global->local map
 
   if (map_style != Atom::MAP_NONE) atom->map_set();
 }
 
+/* ----------------------------------------------------------------------
+   setup direct exchange of forward and reverse comm with adjacent procs
+   trace owning proc and index of each ghost atom through the swaps,
+     ghosts from the same owning proc form a few contiguous ranges
+   send index lists back to owning procs, which become their sendlists
+   create persistent requests for all non-empty messages
+   called at end of borders() when direct_enable is set
+------------------------------------------------------------------------- */
+
+void CommBrick::setup_direct()
+{
+  int i,j,k,m,n,idir;
+  MPI_Request request;
+  double *buf;
+
+  free_direct();
+
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+
+  // origin_dir = offset index of owning proc, origin_index = index on that proc
+  // atoms sent to the left in a swap are to the right of the receiving proc
+
+  int *origin_dir, *origin_index;
+  memory->create(origin_dir,nall,"comm:origin_dir");
+  memory->create(origin_index,nall,"comm:origin_index");
+
+  for (i = 0; i < nlocal; i++) {
+    origin_dir[i] = 13;
+    origin_index[i] = i;
+  }
+
+  const int stride[3] = {9,3,1};
+  int iswap = 0;
+  for (int dim = 0; dim < 3; dim++) {
+    for (int ineed = 0; ineed < 2*maxneed[dim]; ineed++) {
+      const int shift = (ineed % 2 == 0) ? stride[dim] : -stride[dim];
+      n = sendnum[iswap];
+      if (2*n > maxsend) grow_send(2*n,0);
+      for (k = 0; k < n; k++) {
+        j = sendlist[iswap][k];
+        buf_send[2*k] = origin_dir[j];
+        buf_send[2*k+1] = origin_index[j];
+      }
+
+      if (sendproc[iswap] != me) {
+        if (2*recvnum[iswap] > maxrecv) grow_recv(2*recvnum[iswap]);
+        if (recvnum[iswap])
+          MPI_Irecv(buf_recv,2*recvnum[iswap],MPI_DOUBLE,recvproc[iswap],0,world,&request);
+        if (n) MPI_Send(buf_send,2*n,MPI_DOUBLE,sendproc[iswap],0,world);
+        if (recvnum[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+        buf = buf_recv;
+      } else buf = buf_send;
+
+      m = firstrecv[iswap];
+      for (k = 0; k < recvnum[iswap]; k++) {
+        origin_dir[m+k] = static_cast<int> (buf[2*k]) + shift;
+        origin_index[m+k] = static_cast<int> (buf[2*k+1]);
+      }
+      iswap++;
+    }
+  }
+
+  // proc at each offset and PBC adjustment of atoms sent to it
+  // same PBC flags as set in setup() for each dimension that is crossed
+
+  for (idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    const int delta[3] = {idir/9 - 1, (idir/3) % 3 - 1, idir % 3 - 1};
+    int loc[3];
+    sw.pbc_flag = 0;
+    for (k = 0; k < 6; k++) sw.pbc[k] = 0;
+    for (int dim = 0; dim < 3; dim++) {
+      loc[dim] = myloc[dim] + delta[dim];
+      int flag = 0;
+      if (loc[dim] < 0) {
+        loc[dim] = procgrid[dim] - 1;
+        flag = 1;
+      } else if (loc[dim] == procgrid[dim]) {
+        loc[dim] = 0;
+        flag = -1;
+      }
+      if (flag) {
+        sw.pbc_flag = 1;
+        sw.pbc[dim] += flag;
+        if (triclinic) {
+          if (dim == 1) sw.pbc[5] += flag;
+          else if (dim == 2) {
+            sw.pbc[4] += flag;
+            sw.pbc[3] += flag;
+          }
+        }
+      }
+    }
+    sw.proc = grid2proc[loc[0]][loc[1]][loc[2]];
+    sw.nsend = sw.nrecv = sw.nrun = 0;
+    sw.noderank = -1;
+    sw.remote_send = sw.remote_recv = nullptr;
+  }
+
+  // rank of adjacent procs in node communicator, if they are on my node
+
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (shared) {
+    if (nodecomm == MPI_COMM_NULL)
+      MPI_Comm_split_type(world,MPI_COMM_TYPE_SHARED,me,MPI_INFO_NULL,&nodecomm);
+    MPI_Group worldgroup,nodegroup;
+    MPI_Comm_group(world,&worldgroup);
+    MPI_Comm_group(nodecomm,&nodegroup);
+    int procs[27],noderanks[27];
+    for (idir = 0; idir < 27; idir++) procs[idir] = swapdirect[idir].proc;
+    MPI_Group_translate_ranks(worldgroup,27,procs,nodegroup,noderanks);
+    for (idir = 0; idir < 27; idir++)
+      if ((idir != 13) && (procs[idir] != me) && (noderanks[idir] != MPI_UNDEFINED))
+        swapdirect[idir].noderank = noderanks[idir];
+    MPI_Group_free(&worldgroup);
+    MPI_Group_free(&nodegroup);
+  }
+#endif
+
+  // count ghost atoms and contiguous ranges of ghost atoms from each proc
+
+  for (i = nlocal; i < nall; i++) {
+    idir = origin_dir[i];
+    if ((idir < 0) || (idir > 26) || (idir == 13))
+      error->one(FLERR,"Ghost atom is not owned by an adjacent proc in comm_modify direct");
+    swapdirect[idir].nrecv++;
+    if ((i == nlocal) || (origin_dir[i-1] != idir)) swapdirect[idir].nrun++;
+  }
+
+  // exchange counts with all adjacent procs
+  // message for my offset idir is tagged with idir, so that duplicate procs
+  //   at different offsets are distinguished; self messages are copied
+
+  MPI_Request requests[26];
+  int nrequest = 0;
+
+  for (idir = 0; idir < 27; idir++) {
+    if (idir == 13) continue;
+    DirectSwap &sw = swapdirect[idir];
+    if (sw.proc == me) sw.nsend = swapdirect[26-idir].nrecv;
+    else MPI_Irecv(&sw.nsend,1,MPI_INT,sw.proc,DIRECTTAG+26-idir,world,&requests[nrequest++]);
+  }
+  for (idir = 0; idir < 27; idir++) {
+    if ((idir == 13) || (swapdirect[idir].proc == me)) continue;
+    MPI_Send(&swapdirect[idir].nrecv,1,MPI_INT,swapdirect[idir].proc,DIRECTTAG+idir,world);
+  }
+  if (nrequest) MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+
+  // carve sendlists, ranges, and lists of origin indices from direct_list
+
+  n = 0;
+  for (idir = 0; idir < 27; idir++)
+    n += swapdirect[idir].nsend + swapdirect[idir].nrecv + 2*swapdirect[idir].nrun;
+  if (n > maxdirect_list) {
+    maxdirect_list = static_cast<int> (BUFFACTOR * n);
+    memory->destroy(direct_list);
+    memory->create(direct_list,maxdirect_list,"comm:direct_list");
+  }
+
+  int *origin_list[27];
+  int *ptr = direct_list;
+  for (idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    sw.sendlist = ptr;
+    ptr += sw.nsend;
+    origin_list[idir] = ptr;
+    ptr += sw.nrecv;
+    sw.runfirst = ptr;
+    ptr += sw.nrun;
+    sw.runnum = ptr;
+    ptr += sw.nrun;
+    sw.nrecv = sw.nrun = 0;
+  }
+
+  for (i = nlocal; i < nall; i++) {
+    DirectSwap &sw = swapdirect[origin_dir[i]];
+    if ((i == nlocal) || (origin_dir[i-1] != origin_dir[i])) {
+      sw.runfirst[sw.nrun] = i;
+      sw.runnum[sw.nrun++] = 0;
+    }
+    sw.runnum[sw.nrun-1]++;
+    origin_list[origin_dir[i]][sw.nrecv++] = origin_index[i];
+  }
+
+  memory->destroy(origin_dir);
+  memory->destroy(origin_index);
+
+  // origin indices of my ghost atoms are the sendlists of their owning procs
+
+  nrequest = 0;
+  for (idir = 0; idir < 27; idir++) {
+    if (idir == 13) continue;
+    DirectSwap &sw = swapdirect[idir];
+    if (sw.proc == me) {
+      for (k = 0; k < sw.nsend; k++) sw.sendlist[k] = origin_list[26-idir][k];
+    } else if (sw.nsend)
+      MPI_Irecv(sw.sendlist,sw.nsend,MPI_INT,sw.proc,DIRECTTAG+26-idir,world,
+                &requests[nrequest++]);
+  }
+  for (idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc == me) || (sw.nrecv == 0)) continue;
+    MPI_Send(origin_list[idir],sw.nrecv,MPI_INT,sw.proc,DIRECTTAG+idir,world);
+  }
+  if (nrequest) MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+
+  // per neighbor buffers, large enough for forward and reverse comm
+
+  const int size = MAX(size_forward,size_reverse);
+  int nsendall = 0;
+  int nrecvall = 0;
+  for (idir = 0; idir < 27; idir++) {
+    nsendall += swapdirect[idir].nsend;
+    nrecvall += swapdirect[idir].nrecv;
+  }
+  grow_direct(size*nsendall,size*nrecvall);
+
+  nsendall = nrecvall = 0;
+  for (idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    sw.bufsend = buf_direct_send + size*nsendall;
+    sw.bufrecv = buf_direct_recv + size*nrecvall;
+    nsendall += sw.nsend;
+    nrecvall += sw.nrecv;
+  }
+
+  // on-node neighbors exchange offsets of their buffers for each other
+  // and then access them directly in the shared memory windows
+
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (direct_shared) {
+    int offsets[27][2],remote[27][2];
+    nrequest = 0;
+    for (idir = 0; idir < 27; idir++) {
+      DirectSwap &sw = swapdirect[idir];
+      if (sw.noderank < 0) continue;
+      offsets[idir][0] = sw.bufsend - buf_direct_send;
+      offsets[idir][1] = sw.bufrecv - buf_direct_recv;
+      MPI_Irecv(remote[idir],2,MPI_INT,sw.proc,DIRECTTAG+26-idir,world,&requests[nrequest++]);
+    }
+    for (idir = 0; idir < 27; idir++)
+      if (swapdirect[idir].noderank >= 0)
+        MPI_Send(offsets[idir],2,MPI_INT,swapdirect[idir].proc,DIRECTTAG+idir,world);
+    if (nrequest) MPI_Waitall(nrequest,requests,MPI_STATUSES_IGNORE);
+
+    MPI_Aint winsize;
+    int dispunit;
+    double *base;
+    for (idir = 0; idir < 27; idir++) {
+      DirectSwap &sw = swapdirect[idir];
+      if (sw.noderank < 0) continue;
+      MPI_Win_shared_query(win_direct_send,sw.noderank,&winsize,&dispunit,&base);
+      sw.remote_send = base + remote[idir][0];
+      MPI_Win_shared_query(win_direct_recv,sw.noderank,&winsize,&dispunit,&base);
+      sw.remote_recv = base + remote[idir][1];
+    }
+  }
+#endif
+
+  // persistent requests, bound to the per neighbor buffers
+  // forward comm sends from owned atoms and recvs into ghost atoms
+  // reverse comm does the opposite and re-uses the same buffers
+  // no messages to on-node neighbors with shared memory buffers
+
+  for (idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc == me) || (sw.remote_send)) continue;
+    if (sw.nrecv) {
+      MPI_Recv_init(sw.bufrecv,sw.nrecv*size_forward,MPI_DOUBLE,sw.proc,DIRECTTAG+idir,
+                    world,&req_forward_recv[nreq_forward_recv++]);
+      MPI_Send_init(sw.bufrecv,sw.nrecv*size_reverse,MPI_DOUBLE,sw.proc,DIRECTTAG+idir,
+                    world,&req_reverse_send[nreq_reverse_send++]);
+    }
+    if (sw.nsend) {
+      MPI_Send_init(sw.bufsend,sw.nsend*size_forward,MPI_DOUBLE,sw.proc,DIRECTTAG+26-idir,
+                    world,&req_forward_send[nreq_forward_send++]);
+      MPI_Recv_init(sw.bufsend,sw.nsend*size_reverse,MPI_DOUBLE,sw.proc,DIRECTTAG+26-idir,
+                    world,&req_reverse_recv[nreq_reverse_recv++]);
+    }
+  }
+
+  direct_active = 1;
+}
+
+/* ----------------------------------------------------------------------
+   free persistent requests of direct exchange
+------------------------------------------------------------------------- */
+
+void CommBrick::free_direct()
+{
+  for (int i = 0; i < nreq_forward_send; i++) MPI_Request_free(&req_forward_send[i]);
+  for (int i = 0; i < nreq_forward_recv; i++) MPI_Request_free(&req_forward_recv[i]);
+  for (int i = 0; i < nreq_reverse_send; i++) MPI_Request_free(&req_reverse_send[i]);
+  for (int i = 0; i < nreq_reverse_recv; i++) MPI_Request_free(&req_reverse_recv[i]);
+  nreq_forward_send = nreq_forward_recv = 0;
+  nreq_reverse_send = nreq_reverse_recv = 0;
+  direct_active = direct_pending = 0;
+}
+
+/* ----------------------------------------------------------------------
+   grow per neighbor buffers of direct exchange to nsend/nrecv doubles
+   with comm_modify shared, they are allocated in shared memory windows,
+     which is collective over the procs on a node
+------------------------------------------------------------------------- */
+
+void CommBrick::grow_direct(int nsend, int nrecv)
+{
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (shared) {
+    if (!direct_shared) free_direct_buffers();
+    int flag = (nsend > maxdirect_send) || (nrecv > maxdirect_recv) || !direct_shared;
+    int flagall;
+    MPI_Allreduce(&flag,&flagall,1,MPI_INT,MPI_MAX,nodecomm);
+    if (!flagall) return;
+
+    free_direct_buffers();
+    maxdirect_send = static_cast<int> (BUFFACTOR * nsend);
+    maxdirect_recv = static_cast<int> (BUFFACTOR * nrecv);
+    MPI_Win_allocate_shared((MPI_Aint) maxdirect_send * sizeof(double),sizeof(double),
+                            MPI_INFO_NULL,nodecomm,&buf_direct_send,&win_direct_send);
+    MPI_Win_allocate_shared((MPI_Aint) maxdirect_recv * sizeof(double),sizeof(double),
+                            MPI_INFO_NULL,nodecomm,&buf_direct_recv,&win_direct_recv);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK,win_direct_send);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK,win_direct_recv);
+    direct_shared = 1;
+    return;
+  }
+#endif
+
+  if (direct_shared) free_direct_buffers();
+  if (nsend > maxdirect_send) {
+    maxdirect_send = static_cast<int> (BUFFACTOR * nsend);
+    memory->destroy(buf_direct_send);
+    memory->create(buf_direct_send,maxdirect_send,"comm:buf_direct_send");
+  }
+  if (nrecv > maxdirect_recv) {
+    maxdirect_recv = static_cast<int> (BUFFACTOR * nrecv);
+    memory->destroy(buf_direct_recv);
+    memory->create(buf_direct_recv,maxdirect_recv,"comm:buf_direct_recv");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   free per neighbor buffers of direct exchange
+------------------------------------------------------------------------- */
+
+void CommBrick::free_direct_buffers()
+{
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  if (direct_shared) {
+    MPI_Win_unlock_all(win_direct_send);
+    MPI_Win_unlock_all(win_direct_recv);
+    MPI_Win_free(&win_direct_send);
+    MPI_Win_free(&win_direct_recv);
+    buf_direct_send = buf_direct_recv = nullptr;
+    maxdirect_send = maxdirect_recv = 0;
+    direct_shared = 0;
+    return;
+  }
+#endif
+
+  memory->destroy(buf_direct_send);
+  memory->destroy(buf_direct_recv);
+  buf_direct_send = buf_direct_recv = nullptr;
+  maxdirect_send = maxdirect_recv = 0;
+}
+
+/* ----------------------------------------------------------------------
+   make shared memory send (flag = 0) or recv (flag = 1) buffers
+     consistent between all procs on my node
+------------------------------------------------------------------------- */
+
+void CommBrick::sync_direct(int flag)
+{
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  MPI_Win win = flag ? win_direct_recv : win_direct_send;
+  MPI_Win_sync(win);
+  MPI_Barrier(nodecomm);
+  MPI_Win_sync(win);
+#else
+  (void) flag;
+#endif
+}
+
+/* ----------------------------------------------------------------------
+   start direct forward comm of atom coords with all adjacent procs
+   ghost atoms owned by myself are updated right away
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_direct_begin()
+{
+  AtomVec *avec = atom->avec;
+
+  // on-node neighbors must be done reading my previous send buffers
+
+  if (direct_shared) sync_direct(0);
+
+  if (nreq_forward_recv) MPI_Startall(nreq_forward_recv,req_forward_recv);
+
+  for (int idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc == me) || (sw.nsend == 0)) continue;
+    if (ghost_velocity)
+      avec->pack_comm_vel(sw.nsend,sw.sendlist,sw.bufsend,sw.pbc_flag,sw.pbc);
+    else avec->pack_comm(sw.nsend,sw.sendlist,sw.bufsend,sw.pbc_flag,sw.pbc);
+  }
+
+  if (nreq_forward_send) MPI_Startall(nreq_forward_send,req_forward_send);
+
+  for (int idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc != me) || (sw.nsend == 0)) continue;
+    DirectSwap &ghost = swapdirect[26-idir];
+    double *buf = sw.bufsend;
+    if (ghost_velocity) {
+      avec->pack_comm_vel(sw.nsend,sw.sendlist,buf,sw.pbc_flag,sw.pbc);
+      for (int k = 0; k < ghost.nrun; k++) {
+        avec->unpack_comm_vel(ghost.runnum[k],ghost.runfirst[k],buf);
+        buf += ghost.runnum[k]*size_forward;
+      }
+    } else {
+      avec->pack_comm(sw.nsend,sw.sendlist,buf,sw.pbc_flag,sw.pbc);
+      for (int k = 0; k < ghost.nrun; k++) {
+        avec->unpack_comm(ghost.runnum[k],ghost.runfirst[k],buf);
+        buf += ghost.runnum[k]*size_forward;
+      }
+    }
+  }
+
+  if (direct_shared) sync_direct(0);
+}
+
+/* ----------------------------------------------------------------------
+   complete direct forward comm of atom coords
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_direct_end()
+{
+  AtomVec *avec = atom->avec;
+
+  // unpack ghost atoms of on-node neighbors from their shared send buffers
+  // then ghost atoms of other neighbors from messages
+
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      if (nreq_forward_recv)
+        MPI_Waitall(nreq_forward_recv,req_forward_recv,MPI_STATUSES_IGNORE);
+    }
+    for (int idir = 0; idir < 27; idir++) {
+      DirectSwap &sw = swapdirect[idir];
+      if ((idir == 13) || (sw.proc == me) || (sw.nrecv == 0)) continue;
+      if ((pass == 0) != (sw.remote_send != nullptr)) continue;
+      double *buf = (pass == 0) ? sw.remote_send : sw.bufrecv;
+      for (int k = 0; k < sw.nrun; k++) {
+        if (ghost_velocity) avec->unpack_comm_vel(sw.runnum[k],sw.runfirst[k],buf);
+        else avec->unpack_comm(sw.runnum[k],sw.runfirst[k],buf);
+        buf += sw.runnum[k]*size_forward;
+      }
+    }
+  }
+
+  if (nreq_forward_send) MPI_Waitall(nreq_forward_send,req_forward_send,MPI_STATUSES_IGNORE);
+}
+
+/* ----------------------------------------------------------------------
+   direct reverse comm of forces with all adjacent procs
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_direct()
+{
+  AtomVec *avec = atom->avec;
+  double *buf;
+
+  // on-node neighbors must be done reading my previous recv buffers
+
+  if (direct_shared) sync_direct(1);
+
+  if (nreq_reverse_recv) MPI_Startall(nreq_reverse_recv,req_reverse_recv);
+
+  for (int idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc == me) || (sw.nrecv == 0)) continue;
+    buf = sw.bufrecv;
+    for (int k = 0; k < sw.nrun; k++)
+      buf += avec->pack_reverse(sw.runnum[k],sw.runfirst[k],buf);
+  }
+
+  if (nreq_reverse_send) MPI_Startall(nreq_reverse_send,req_reverse_send);
+
+  // ghost atoms owned by myself
+
+  for (int idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc != me) || (sw.nrecv == 0)) continue;
+    buf = sw.bufrecv;
+    for (int k = 0; k < sw.nrun; k++)
+      buf += avec->pack_reverse(sw.runnum[k],sw.runfirst[k],buf);
+    DirectSwap &owned = swapdirect[26-idir];
+    avec->unpack_reverse(owned.nsend,owned.sendlist,sw.bufrecv);
+  }
+
+  // forces of on-node neighbors from their shared recv buffers
+
+  if (direct_shared) {
+    sync_direct(1);
+    for (int idir = 0; idir < 27; idir++) {
+      DirectSwap &sw = swapdirect[idir];
+      if ((idir == 13) || (sw.proc == me) || (sw.nsend == 0) || !sw.remote_recv) continue;
+      avec->unpack_reverse(sw.nsend,sw.sendlist,sw.remote_recv);
+    }
+  }
+
+  if (nreq_reverse_recv) MPI_Waitall(nreq_reverse_recv,req_reverse_recv,MPI_STATUSES_IGNORE);
+
+  for (int idir = 0; idir < 27; idir++) {
+    DirectSwap &sw = swapdirect[idir];
+    if ((idir == 13) || (sw.proc == me) || (sw.nsend == 0) || sw.remote_recv) continue;
+    avec->unpack_reverse(sw.nsend,sw.sendlist,sw.bufsend);
+  }
+
+  if (nreq_reverse_send) MPI_Waitall(nreq_reverse_send,req_reverse_send,MPI_STATUSES_IGNORE);
+}
+
 /* ----------------------------------------------------------------------
    forward communication invoked by a Pair
    nsize used only to set recv buffer limit
@@ -1210,6 +1996,130 @@ void CommBrick::reverse_comm(Fix *fix, int size)
   }
 }
 
+/* ----------------------------------------------------------------------
+   forward communication of all clients queued with add_batch()
+   one message per swap holds the data of all clients back to back,
+     preceded by a header with the # of values packed by each client
+------------------------------------------------------------------------- */
+
+void CommBrick::forward_comm_batch()
+{
+  int i,iswap,m,n,nsize;
+  double *buf;
+  MPI_Request request;
+
+  // a single client needs no header
+
+  if (nbatch <= 1) {
+    Comm::forward_comm_batch();
+    return;
+  }
+
+  nsize = 0;
+  for (i = 0; i < nbatch; i++) nsize += batch_size(i,0);
+
+  for (iswap = 0; iswap < nswap; iswap++) {
+
+    // pack buffer
+
+    n = nsize*sendnum[iswap] + nbatch;
+    if (n > maxsend) grow_send(n,0);
+    n = nbatch;
+    for (i = 0; i < nbatch; i++) {
+      m = batch_pack_forward(i,sendnum[iswap],sendlist[iswap],&buf_send[n],
+                             pbc_flag[iswap],pbc[iswap]);
+      buf_send[i] = m;
+      n += m;
+    }
+
+    // exchange with another proc
+    // if self, set recv buffer to send buffer
+
+    if (sendproc[iswap] != me) {
+      if (recvnum[iswap]) {
+        m = nsize*recvnum[iswap] + nbatch;
+        if (m > maxrecv) grow_recv(m);
+        MPI_Irecv(buf_recv,m,MPI_DOUBLE,recvproc[iswap],0,world,&request);
+      }
+      if (sendnum[iswap])
+        MPI_Send(buf_send,n,MPI_DOUBLE,sendproc[iswap],0,world);
+      if (recvnum[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+      buf = buf_recv;
+    } else buf = buf_send;
+
+    // unpack buffer
+
+    if (recvnum[iswap] == 0) continue;
+    n = nbatch;
+    for (i = 0; i < nbatch; i++) {
+      batch_unpack_forward(i,recvnum[iswap],firstrecv[iswap],&buf[n]);
+      n += static_cast<int> (buf[i]);
+    }
+  }
+
+  nbatch = 0;
+}
+
+/* ----------------------------------------------------------------------
+   reverse communication of all clients queued with add_batch()
+   same message layout as forward_comm_batch()
+------------------------------------------------------------------------- */
+
+void CommBrick::reverse_comm_batch()
+{
+  int i,iswap,m,n,nsize;
+  double *buf;
+  MPI_Request request;
+
+  if (nbatch <= 1) {
+    Comm::reverse_comm_batch();
+    return;
+  }
+
+  nsize = 0;
+  for (i = 0; i < nbatch; i++) nsize += batch_size(i,1);
+
+  for (iswap = nswap-1; iswap >= 0; iswap--) {
+
+    // pack buffer
+
+    n = nsize*recvnum[iswap] + nbatch;
+    if (n > maxsend) grow_send(n,0);
+    n = nbatch;
+    for (i = 0; i < nbatch; i++) {
+      m = batch_pack_reverse(i,recvnum[iswap],firstrecv[iswap],&buf_send[n]);
+      buf_send[i] = m;
+      n += m;
+    }
+
+    // exchange with another proc
+    // if self, set recv buffer to send buffer
+
+    if (sendproc[iswap] != me) {
+      if (sendnum[iswap]) {
+        m = nsize*sendnum[iswap] + nbatch;
+        if (m > maxrecv) grow_recv(m);
+        MPI_Irecv(buf_recv,m,MPI_DOUBLE,sendproc[iswap],0,world,&request);
+      }
+      if (recvnum[iswap])
+        MPI_Send(buf_send,n,MPI_DOUBLE,recvproc[iswap],0,world);
+      if (sendnum[iswap]) MPI_Wait(&request,MPI_STATUS_IGNORE);
+      buf = buf_recv;
+    } else buf = buf_send;
+
+    // unpack buffer
+
+    if (sendnum[iswap] == 0) continue;
+    n = nbatch;
+    for (i = 0; i < nbatch; i++) {
+      batch_unpack_reverse(i,sendnum[iswap],sendlist[iswap],&buf[n]);
+      n += static_cast<int> (buf[i]);
+    }
+  }
+
+  nbatch = 0;
+}
+
 /* ----------------------------------------------------------------------
    reverse communication invoked by a Fix with variable size data
    query fix for pack size to ensure buf_send is big enough
@@ -1651,5 +2561,9 @@ double CommBrick::memory_usage()
     bytes += memory->usage(sendlist[i],maxsendlist[i]);
   bytes += memory->usage(buf_send,maxsend+bufextra);
   bytes += memory->usage(buf_recv,maxrecv);
+  bytes += (double)maxsend_overlap * sizeof(double);
+  bytes += (double)maxdirect_list * sizeof(int);
+  bytes += (double)(maxdirect_send + maxdirect_recv) * sizeof(double);
+  bytes += (double)3 * maxxref * sizeof(double);
   return bytes;
 }
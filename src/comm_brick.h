@@ -32,6 +32,9 @@ class CommBrick : public Comm {
   void exchange() override;                     // move atoms to new procs
   void borders() override;                      // setup list of atoms to comm
 
+  void forward_comm_begin() override;    // start forward comm of atom coords
+  void forward_comm_end() override;      // complete forward comm of atom coords
+
   void forward_comm(class Pair *) override;                 // forward comm from a Pair
   void reverse_comm(class Pair *) override;                 // reverse comm from a Pair
   void forward_comm(class Bond *) override;                 // forward comm from a Bond
@@ -43,6 +46,8 @@ class CommBrick : public Comm {
   void reverse_comm(class Compute *) override;              // reverse from a Compute
   void forward_comm(class Dump *) override;                 // forward comm from a Dump
   void reverse_comm(class Dump *) override;                 // reverse comm from a Dump
+  void forward_comm_batch() override;                       // forward comm from batched clients
+  void reverse_comm_batch() override;                       // reverse comm from batched clients
 
   void forward_comm_array(int, double **) override;            // forward comm of array
   void *extract(const char *, int &) override;
@@ -77,6 +82,76 @@ class CommBrick : public Comm {
   int maxsend, maxrecv;    // current size of send/recv buffer
   int smax, rmax;          // max size in atoms of single borders send/recv
 
+  int noverlap;                      // # of swaps started by forward_comm_begin()
+  int nrequest_overlap;              // # of pending requests for those swaps
+  MPI_Request request_overlap[4];    // pending requests for those swaps
+  double *buf_send_overlap;          // send buffer for 2nd of those swaps
+  int maxsend_overlap;               // current size of buf_send_overlap
+
+  void forward_comm_swaps(int);    // forward comm of atom coords from a swap on
+
+  // direct exchange with up to 26 neighbor procs via persistent requests
+  // requires that all ghost atoms are owned by adjacent procs
+  // index = 9*(dx+1) + 3*(dy+1) + (dz+1) for neighbor proc at offset dx,dy,dz
+  //   in the proc grid, index 13 is myself and unused
+
+  struct DirectSwap {
+    int proc;                    // proc at this offset
+    int nsend, nrecv;            // # of owned atoms to send, # of ghost atoms to recv
+    int *sendlist;               // list of owned atoms to send
+    int nrun;                    // # of contiguous ranges of ghost atoms to recv
+    int *runfirst, *runnum;      // 1st ghost atom and # of ghost atoms in each range
+    int pbc_flag, pbc[6];        // PBC adjustment for sent atoms
+    double *bufsend, *bufrecv;   // send/recv buffer for this neighbor
+    int noderank;                // rank in node communicator, -1 if not on-node
+    double *remote_send;         // send buffer of on-node neighbor for me
+    double *remote_recv;         // recv buffer of on-node neighbor for me
+  };
+
+  int direct_enable;                         // 1 if direct exchange is possible
+  int direct_active;                         // 1 if direct exchange is set up
+  int direct_pending;                        // 1 if forward comm was started
+  int direct_warn;                           // 1 if warned about no direct exchange
+  DirectSwap swapdirect[27];                 // per neighbor data
+  int *direct_list;                          // storage of sendlists and ranges
+  int maxdirect_list;                        // current size of direct_list
+  double *buf_direct_send, *buf_direct_recv; // storage of per neighbor buffers
+  int maxdirect_send, maxdirect_recv;        // current size of those buffers
+  int nreq_forward_send, nreq_forward_recv;  // # of persistent requests
+  int nreq_reverse_send, nreq_reverse_recv;
+  MPI_Request req_forward_send[26], req_forward_recv[26];
+  MPI_Request req_reverse_send[26], req_reverse_recv[26];
+
+  // with comm_modify shared, buffers are in MPI-3 shared memory windows
+  // and on-node neighbors read each other's buffers instead of messaging
+
+  int direct_shared;    // 1 if per neighbor buffers are in shared memory
+#if defined(MPI_VERSION) && (MPI_VERSION > 2)
+  MPI_Comm nodecomm;          // communicator of procs on my node
+  MPI_Win win_direct_send;    // shared memory window of buf_direct_send
+  MPI_Win win_direct_recv;    // shared memory window of buf_direct_recv
+#endif
+
+  void setup_direct();                // setup direct exchange after borders
+  void grow_direct(int, int);         // grow per neighbor buffers
+  void free_direct_buffers();         // free per neighbor buffers
+  void sync_direct(int);              // sync shared memory buffers of on-node procs
+  void free_direct();                 // free persistent requests
+  void forward_comm_direct_begin();   // start direct forward comm
+  void forward_comm_direct_end();     // complete direct forward comm
+  void reverse_comm_direct();         // direct reverse comm
+
+  // with comm_modify precision single, ghost coords are sent as single precision
+  // displacements from reference coords stored when the ghost atoms were rebuilt
+
+  int xsingle_active;    // 1 if single precision forward comm is used
+  int xref_pending;      // 1 if reference coords must be stored at next forward comm
+  int maxxref;           // current length of xref
+  double **xref;         // reference coords of owned and ghost atoms
+
+  void forward_comm_single();    // forward comm of displacements of atom coords
+  void store_xref();             // store current coords as reference
+
   // NOTE: init_buffers is called from a constructor and must not be made virtual
   void init_buffers();
 
@@ -160,11 +160,11 @@ void CreateBonds::command(int narg, char **arg)
   else if (style == SIMPROPER)
     single_improper();
 
-  // trigger special list build
+  // update special lists for the new bonds
 
   if (specialflag) {
     Special special(lmp);
-    special.build();
+    special.update(newbonds.size() / 2, newbonds.data());
   }
 }
 
@@ -300,6 +300,10 @@ void CreateBonds::many()
         bond_atom[i][num_bond[i]] = tag[j];
         num_bond[i]++;
       }
+      if (tag[i] < tag[j]) {
+        newbonds.push_back(tag[i]);
+        newbonds.push_back(tag[j]);
+      }
     }
   }
   neighbor->init();
@@ -354,6 +358,9 @@ void CreateBonds::single_bond()
   }
   atom->nbonds++;
 
+  newbonds.push_back(batom1);
+  newbonds.push_back(batom2);
+
   if (force->newton_bond) return;
 
   m = idx2;
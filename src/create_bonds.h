@@ -22,6 +22,8 @@ CommandStyle(create_bonds,CreateBonds);
 
 #include "command.h"
 
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class CreateBonds : public Command {
@@ -34,6 +36,7 @@ class CreateBonds : public Command {
   int btype, atype, dtype;
   tagint batom1, batom2, aatom1, aatom2, aatom3, datom1, datom2, datom3, datom4;
   double rmin, rmax;
+  std::vector<tagint> newbonds;    // atom ID pairs of bonds added by this proc
 
   void many();
   void single_bond();
@@ -50,8 +50,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
     format_default(nullptr), format_line_user(nullptr), format_float_user(nullptr),
     format_int_user(nullptr), format_bigint_user(nullptr), format_column_user(nullptr), fp(nullptr),
     nameslist(nullptr), buf(nullptr), sbuf(nullptr), ids(nullptr), bufsort(nullptr),
-    idsort(nullptr), index(nullptr), proclist(nullptr), xpbc(nullptr), vpbc(nullptr),
-    imagepbc(nullptr), irregular(nullptr)
+    idsort(nullptr), index(nullptr), proclist(nullptr), abuf(nullptr), xpbc(nullptr),
+    vpbc(nullptr), imagepbc(nullptr), irregular(nullptr)
 {
   MPI_Comm_rank(world, &me);
   MPI_Comm_size(world, &nprocs);
@@ -78,6 +78,8 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
   append_flag = 0;
   buffer_allow = 0;
   buffer_flag = 0;
+  async_allow = 0;
+  async_flag = 0;
   padflag = 0;
   pbcflag = 0;
   time_flag = 0;
@@ -95,6 +97,7 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
   maxbuf = maxids = maxsort = maxproc = 0;
   maxsbuf = 0;
+  maxabuf = 0;
 
   maxpbc = -1;
 
@@ -143,6 +146,11 @@ Dump::Dump(LAMMPS *lmp, int /*narg*/, char **arg) :
 
 Dump::~Dump()
 {
+  // background writer must finish before file and buffers are released
+  // owner should have called async_wait() before deleting a derived class
+
+  async_wait(0);
+
   delete[] id;
   delete[] style;
   delete[] filename;
@@ -169,6 +177,7 @@ Dump::~Dump()
   delete irregular;
 
   memory->destroy(sbuf);
+  memory->sfree(abuf);
 
   if (pbcflag) {
     memory->destroy(xpbc);
@@ -202,8 +211,13 @@ Dump::~Dump()
 
 void Dump::init()
 {
+  async_wait();
+
   init_style();
 
+  if (async_flag && (async_allow == 0))
+    error->all(FLERR,"Dump_modify async yes not allowed for dump style {}", style);
+
   if (!sort_flag) {
     memory->destroy(bufsort);
     memory->destroy(ids);
@@ -333,6 +347,10 @@ void Dump::write()
   imageint *imagehold;
   double **xhold,**vhold;
 
+  // previous snapshot must be completely written before any state changes
+
+  async_wait();
+
   // simulation box bounds
 
   if (domain->triclinic == 0) {
@@ -455,8 +473,9 @@ void Dump::write()
   // if buffering, convert doubles into strings
   // ensure sbuf is sized for communicating
   // cannot buffer if output is to binary file
+  // with async output, conversion is done by the background writer
 
-  if (buffer_flag && !binary) {
+  if (buffer_flag && !binary && !async_flag) {
     nsme = convert_string(nme,buf);
     int nsmin,nsmax;
     MPI_Allreduce(&nsme,&nsmin,1,MPI_INT,MPI_MIN,world);
@@ -478,9 +497,44 @@ void Dump::write()
   MPI_Status status;
   MPI_Request request;
 
+  // async output: gather buf of doubles from my cluster into abuf
+  // hand abuf to background thread for formatting, writing and closing
+
+  if (async_flag) {
+    if (filewriter) {
+      if (nheader*size_one > maxabuf) {
+        maxabuf = nheader*size_one;
+        memory->sfree(abuf);
+        abuf = (double *) memory->smalloc(maxabuf*sizeof(double),"dump:abuf");
+      }
+      alines.resize(nclusterprocs);
+
+      bigint offset = 0;
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        if (iproc) {
+          MPI_Irecv(&abuf[offset],maxbuf,MPI_DOUBLE,me+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_DOUBLE,&nlines);
+          nlines /= size_one;
+        } else {
+          nlines = nme;
+          if (nme) memcpy(abuf,buf,sizeof(double)*nme*size_one);
+        }
+        alines[iproc] = nlines;
+        offset += (bigint) nlines*size_one;
+      }
+
+      async_thread = std::thread(&Dump::async_write,this);
+
+    } else {
+      MPI_Recv(&tmp,0,MPI_INT,fileproc,0,world,MPI_STATUS_IGNORE);
+      MPI_Rsend(buf,nme*size_one,MPI_DOUBLE,fileproc,0,world);
+    }
+
   // comm and output buf of doubles
 
-  if (buffer_flag == 0 || binary) {
+  } else if (buffer_flag == 0 || binary) {
     if (filewriter) {
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
         if (iproc) {
@@ -535,6 +589,10 @@ void Dump::write()
 
   if (refreshflag) modify->compute[irefresh]->refresh();
 
+  // footer, error check, and closing of file is done by background writer
+
+  if (async_flag) return;
+
   if (filewriter && fp != nullptr) write_footer();
 
   if (fp && ferror(fp)) error->one(FLERR,"Error writing dump {}: {}", id, utils::getsyserror());
@@ -551,6 +609,63 @@ void Dump::write()
   }
 }
 
+/* ----------------------------------------------------------------------
+   format and write snapshot stored in abuf, called in background thread
+   must not use MPI or error class, errors are stored in async_error
+------------------------------------------------------------------------- */
+
+void Dump::async_write()
+{
+  bigint offset = 0;
+  for (const auto &nlines : alines) {
+    double *mybuf = &abuf[offset];
+    if (buffer_flag && !binary) {
+      nsme = convert_string(nlines,mybuf);
+      if (nsme < 0) {
+        async_error = "Too much buffered per-proc info for dump";
+        break;
+      }
+      write_data(nsme,(double *) sbuf);
+    } else write_data(nlines,mybuf);
+    offset += (bigint) nlines*size_one;
+  }
+  if (flush_flag && fp) fflush(fp);
+
+  if (fp != nullptr) write_footer();
+
+  if (fp && ferror(fp))
+    async_error = fmt::format("Error writing dump {}: {}", id, utils::getsyserror());
+
+  if (multifile) {
+    if (compressed) {
+      if (fp != nullptr) platform::pclose(fp);
+    } else {
+      if (fp != nullptr) fclose(fp);
+    }
+    fp = nullptr;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   wait for background writer to complete previous snapshot
+   report any error it encountered
+   errflag = 0 when called from a destructor, which must not throw,
+     so the error is only printed as a warning
+------------------------------------------------------------------------- */
+
+void Dump::async_wait(int errflag)
+{
+  if (!async_thread.joinable()) return;
+  async_thread.join();
+
+  if (!async_error.empty()) {
+    std::string mesg = async_error;
+    async_error.clear();
+    if (errflag) error->one(FLERR,mesg);
+    else error->warning(FLERR,mesg);
+  }
+}
+
 /* ----------------------------------------------------------------------
    generic opening of a dump file
    ASCII or binary or compressed
@@ -1054,6 +1169,8 @@ void Dump::modify_params(int narg, char **arg)
 {
   if (narg == 0) utils::missing_cmd_args(FLERR, "dump_modify", error);
 
+  async_wait();
+
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg],"append") == 0) {
@@ -1061,6 +1178,13 @@ void Dump::modify_params(int narg, char **arg)
       append_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
       iarg += 2;
 
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify async", error);
+      async_flag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (async_flag && async_allow == 0)
+        error->all(FLERR,"Dump_modify async yes not allowed for this style");
+      iarg += 2;
+
     } else if (strcmp(arg[iarg],"balance") == 0) {
       if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "dump_modify balance", error);
       if (nprocs > 1)
@@ -1358,6 +1482,7 @@ double Dump::memory_usage()
 {
   double bytes = memory->usage(buf,maxbuf);
   bytes += memory->usage(sbuf,maxsbuf);
+  bytes += (double)maxabuf * sizeof(double);
   if (sort_flag) {
     if (sortcol == 0) bytes += memory->usage(ids,maxids);
     bytes += memory->usage(bufsort,size_one*maxsort);
@@ -17,6 +17,7 @@
 #include "pointers.h"    // IWYU pragma: export
 
 #include <map>
+#include <thread>
 
 namespace LAMMPS_NS {
 
@@ -57,6 +58,7 @@ class Dump : protected Pointers {
   virtual void unpack_reverse_comm(int, int *, double *) {}
 
   void modify_params(int, char **);
+  void async_wait(int errflag = 1);
   virtual double memory_usage();
 
  protected:
@@ -79,6 +81,8 @@ class Dump : protected Pointers {
   int append_flag;          // 1 if open file in append mode, 0 if not
   int buffer_allow;         // 1 if style allows for buffer_flag, 0 if not
   int buffer_flag;          // 1 if buffer output as one big string, 0 if not
+  int async_allow;          // 1 if style allows for async_flag, 0 if not
+  int async_flag;           // 1 if filewriter formats/writes in a background thread
   int padflag;              // timestep padding in filename
   int pbcflag;              // 1 if remap dumped atoms via PBC, 0 if not
   int singlefile_opened;    // 1 = one big file, already opened, else 0
@@ -150,6 +154,12 @@ class Dump : protected Pointers {
   tagint *idsort;
   int *index, *proclist;
 
+  bigint maxabuf;                // size of abuf
+  double *abuf;                  // snapshot handed off to background writer
+  std::vector<int> alines;       // # of lines from each proc of cluster in abuf
+  std::thread async_thread;      // background writer thread
+  std::string async_error;       // error message from background writer
+
   double **xpbc, **vpbc;
   imageint *imagepbc;
   int maxpbc;
@@ -186,6 +196,7 @@ class Dump : protected Pointers {
   static int bufcompare_reverse(const int, const int, void *);
 #endif
   void balance();
+  void async_write();
 };
 
 }    // namespace LAMMPS_NS
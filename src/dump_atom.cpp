@@ -38,6 +38,7 @@ DumpAtom::DumpAtom(LAMMPS *lmp, int narg, char **arg) :
   image_flag = 0;
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
   format_default = nullptr;
   key2col = { { "id", 0 }, { "type", 1 }, { "x", 2 }, { "y", 3 },
               { "z", 4 }, { "ix", 5 }, { "iy", 6 }, { "iz", 7 } };
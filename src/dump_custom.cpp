@@ -87,6 +87,7 @@ DumpCustom::DumpCustom(LAMMPS *lmp, int narg, char **arg) :
 
   buffer_allow = 1;
   buffer_flag = 1;
+  async_allow = 1;
 
   nthresh = 0;
   nthreshlast = 0;
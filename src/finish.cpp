@@ -75,6 +75,10 @@ void Finish::end(int flag)
 
   const int nthreads = comm->nthreads;
 
+  // files written in background must be complete at end of run
+
+  output->async_wait();
+
   // recompute natoms in case atoms have been lost
 
   bigint nblocal = atom->nlocal;
@@ -34,7 +34,7 @@
 using namespace LAMMPS_NS;
 using namespace FixConst;
 
-enum{SHIFT,BISECTION};
+enum{SHIFT,BISECTION,RELAX};
 
 /* ---------------------------------------------------------------------- */
 
@@ -62,6 +62,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   if (strcmp(arg[5],"shift") == 0) lbstyle = SHIFT;
   else if (strcmp(arg[5],"rcb") == 0) lbstyle = BISECTION;
+  else if (strcmp(arg[5],"rcb/relax") == 0) lbstyle = RELAX;
   else error->all(FLERR,"Illegal fix balance command");
 
   int iarg = 5;
@@ -79,6 +80,11 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   } else if (lbstyle == BISECTION) {
     iarg++;
+
+  } else if (lbstyle == RELAX) {
+    if (iarg+2 > narg) error->all(FLERR,"Illegal fix balance command");
+    maxshift = utils::numeric(FLERR,arg[iarg+1],false,lmp);
+    iarg += 2;
   }
 
   // error checks
@@ -98,6 +104,8 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   if (lbstyle == BISECTION && comm->style == Comm::BRICK)
     error->all(FLERR,"Fix balance rcb cannot be used with comm_style brick");
+  if (lbstyle == RELAX && comm->style == Comm::BRICK)
+    error->all(FLERR,"Fix balance rcb/relax cannot be used with comm_style brick");
 
   // create instance of Balance class
   // if SHIFT, initialize it with params
@@ -105,6 +113,7 @@ FixBalance::FixBalance(LAMMPS *lmp, int narg, char **arg) :
 
   balance = new Balance(lmp);
   if (lbstyle == SHIFT) balance->shift_setup(bstr,nitermax,thresh);
+  if (lbstyle == RELAX) balance->relax_setup(maxshift);
   balance->options(iarg,narg,arg,0);
   wtflag = balance->wtflag;
   sortflag = balance->sortflag;
@@ -268,13 +277,17 @@ void FixBalance::rebalance()
 
   // invoke balancer and reset comm->uniform flag
 
-  int *sendproc;
+  int *sendproc = nullptr;
   if (lbstyle == SHIFT) {
     itercount = balance->shift();
     comm->layout = Comm::LAYOUT_NONUNIFORM;
   } else if (lbstyle == BISECTION) {
     sendproc = balance->bisection();
     comm->layout = Comm::LAYOUT_TILED;
+  } else if (lbstyle == RELAX) {
+    if (comm->layout == Comm::LAYOUT_TILED) sendproc = balance->relax();
+    else sendproc = balance->bisection();
+    comm->layout = Comm::LAYOUT_TILED;
   }
 
   // reset proc sub-domains
@@ -303,7 +316,8 @@ void FixBalance::rebalance()
 
   if (domain->triclinic) domain->x2lamda(atom->nlocal);
   if (wtflag) balance->fixstore->disable = 0;
-  if (lbstyle == BISECTION) irregular->migrate_atoms(sortflag,1,sendproc);
+  if (lbstyle == BISECTION || lbstyle == RELAX)
+    irregular->migrate_atoms(sortflag,1,sendproc);
   else if (irregular->migrate_check()) irregular->migrate_atoms(sortflag);
   if (domain->triclinic) domain->lamda2x(atom->nlocal);
 
@@ -42,6 +42,7 @@ class FixBalance : public Fix {
  private:
   int nevery, lbstyle, nitermax;
   double thresh, stopthresh;
+  double maxshift;
   char bstr[4];
   int wtflag;               // 1 for weighted balancing
   int sortflag;             // 1 for sorting comm messages
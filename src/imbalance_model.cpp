@@ -0,0 +1,371 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "imbalance_model.h"
+
+#include "atom.h"
+#include "error.h"
+#include "fix.h"
+#include "force.h"
+#include "group.h"
+#include "memory.h"
+#include "modify.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "timer.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+using namespace LAMMPS_NS;
+
+static constexpr double RIDGE = 1.0e-3;     // regularization relative to diagonal of fit
+static constexpr double MINWT = 1.0e-2;     // min weight relative to average cost per atom
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceModel::ImbalanceModel(LAMMPS *lmp) :
+    Imbalance(lmp), gid(nullptr), fixid(nullptr), fixbit(nullptr), amat(nullptr), bvec(nullptr),
+    coeff(nullptr), numneigh(nullptr)
+{
+  decay = 0.5;
+  ngroup = nfix = 0;
+  ntypes = nfeature = 0;
+  last = 0.0;
+  laststep = -1;
+  nsample = 0;
+  costsum = atomsum = 0.0;
+  maxneigh = 0;
+}
+
+/* -------------------------------------------------------------------- */
+
+ImbalanceModel::~ImbalanceModel()
+{
+  delete[] gid;
+  for (int i = 0; i < nfix; i++) delete[] fixid[i];
+  delete[] fixid;
+  delete[] fixbit;
+  memory->destroy(amat);
+  memory->destroy(bvec);
+  memory->destroy(coeff);
+  memory->destroy(numneigh);
+}
+
+/* -------------------------------------------------------------------- */
+
+int ImbalanceModel::options(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR, "Illegal balance weight command");
+  decay = utils::numeric(FLERR, arg[0], false, lmp);
+  if (decay < 0.0 || decay >= 1.0) error->all(FLERR, "Illegal balance weight command");
+
+  // count and store optional group and fix features
+
+  int iarg = 1;
+  while (iarg + 1 < narg) {
+    if (strcmp(arg[iarg], "group") == 0) ngroup++;
+    else if (strcmp(arg[iarg], "fix") == 0) nfix++;
+    else break;
+    iarg += 2;
+  }
+
+  gid = new int[ngroup];
+  fixid = new char *[nfix];
+  fixbit = new int[nfix];
+  ngroup = nfix = 0;
+
+  iarg = 1;
+  while (iarg + 1 < narg) {
+    if (strcmp(arg[iarg], "group") == 0) {
+      gid[ngroup] = group->find(arg[iarg + 1]);
+      if (gid[ngroup] < 0)
+        error->all(FLERR, "Unknown group in balance weight command: {}", arg[iarg + 1]);
+      ngroup++;
+    } else if (strcmp(arg[iarg], "fix") == 0) {
+      fixid[nfix] = utils::strdup(arg[iarg + 1]);
+      fixbit[nfix] = 0;
+      nfix++;
+    } else break;
+    iarg += 2;
+  }
+
+  allocate();
+  return iarg;
+}
+
+/* ----------------------------------------------------------------------
+   allocate and zero the fit
+   features = one per atom type, # of neighbors, one per group or fix
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::allocate()
+{
+  ntypes = atom->ntypes;
+  nfeature = ntypes + 1 + ngroup + nfix;
+
+  memory->destroy(amat);
+  memory->destroy(bvec);
+  memory->destroy(coeff);
+  memory->create(amat, nfeature, nfeature, "imbalance:amat");
+  memory->create(bvec, nfeature, "imbalance:bvec");
+  memory->create(coeff, nfeature, "imbalance:coeff");
+
+  for (int k = 0; k < nfeature; k++) {
+    for (int l = 0; l < nfeature; l++) amat[k][l] = 0.0;
+    bvec[k] = coeff[k] = 0.0;
+  }
+  costsum = atomsum = 0.0;
+  nsample = 0;
+}
+
+/* ----------------------------------------------------------------------
+   reset last and timers if necessary, look up fix features
+   fitted model is kept, so it improves across runs
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::init(int flag)
+{
+  if (atom->ntypes != ntypes) allocate();
+
+  for (int m = 0; m < nfix; m++) {
+    auto ifix = modify->get_fix_by_id(fixid[m]);
+    if (!ifix) error->all(FLERR, "Unknown fix in balance weight command: {}", fixid[m]);
+    fixbit[m] = ifix->groupbit;
+  }
+
+  last = 0.0;
+
+  // flag = 1 if called from FixBalance at start of run
+  //   init Timer, so accumulated time not carried over from previous run
+  //   normalize time by # of steps since last call, so samples are comparable
+  // should NOT init Timer if called from Balance, it uses time from last run
+
+  if (flag) {
+    timer->init();
+    laststep = update->ntimestep;
+  } else laststep = -1;
+}
+
+/* ----------------------------------------------------------------------
+   per-atom neighbor counts from neighbor list of the pair style
+   zero if there is no suitable list, then the feature has no effect
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::count_neighbors()
+{
+  const int nlocal = atom->nlocal;
+  if (nlocal > maxneigh) {
+    maxneigh = atom->nmax;
+    memory->destroy(numneigh);
+    memory->create(numneigh, maxneigh, "imbalance:numneigh");
+  }
+  for (int i = 0; i < nlocal; i++) numneigh[i] = 0;
+
+  NeighList *list = nullptr;
+  if (force->pair) list = force->pair->list;
+  if (!list || list->kokkos || !list->numneigh || (neighbor->ago < 0)) return;
+
+  const int inum = list->inum;
+  const int *const ilist = list->ilist;
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    if (i < nlocal) numneigh[i] = list->numneigh[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   features of owned atom I
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::features(int i, double *f)
+{
+  const int *const mask = atom->mask;
+  const int *const bitmask = group->bitmask;
+
+  for (int k = 0; k < nfeature; k++) f[k] = 0.0;
+  f[atom->type[i] - 1] = 1.0;
+  f[ntypes] = numneigh[i];
+  for (int m = 0; m < ngroup; m++)
+    if (mask[i] & bitmask[gid[m]]) f[ntypes + 1 + m] = 1.0;
+  for (int m = 0; m < nfix; m++)
+    if (mask[i] & fixbit[m]) f[ntypes + 1 + ngroup + m] = 1.0;
+}
+
+/* ----------------------------------------------------------------------
+   add the per-proc costs since last call as samples to the fit
+   each proc is one sample: its cost = sum of feature costs of its atoms
+   earlier samples are down-weighted by decay
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::compute(double *weight)
+{
+  const int nlocal = atom->nlocal;
+  count_neighbors();
+
+  double *f = new double[nfeature];
+
+  // cost = CPU time for relevant timers since last invocation
+  // include time in fixes if fix features are used
+  // require 0.1 seconds on some proc to avoid fitting to bogus timings
+  //   due to limited timer resolution/precision
+
+  if (timer->has_normal()) {
+    double cost = -last;
+    cost += timer->get_wall(Timer::PAIR);
+    cost += timer->get_wall(Timer::NEIGH);
+    cost += timer->get_wall(Timer::BOND);
+    cost += timer->get_wall(Timer::KSPACE);
+    if (nfix) cost += timer->get_wall(Timer::MODIFY);
+
+    double maxcost;
+    MPI_Allreduce(&cost, &maxcost, 1, MPI_DOUBLE, MPI_MAX, world);
+    bigint nsteps = 1;
+    if (laststep >= 0) nsteps = update->ntimestep - laststep;
+
+    if (maxcost > 0.1 && nsteps > 0) {
+      last += cost;
+      if (laststep >= 0) laststep = update->ntimestep;
+      cost /= nsteps;
+
+      // sum features over my atoms
+      // one allreduce for normal equations, total cost and atom count
+
+      int n = nfeature * nfeature + nfeature + 2;
+      auto mine = new double[n];
+      auto all = new double[n];
+      auto fsum = new double[nfeature];
+      for (int k = 0; k < nfeature; k++) fsum[k] = 0.0;
+      for (int i = 0; i < nlocal; i++) {
+        features(i, f);
+        for (int k = 0; k < nfeature; k++) fsum[k] += f[k];
+      }
+
+      int m = 0;
+      for (int k = 0; k < nfeature; k++)
+        for (int l = 0; l < nfeature; l++) mine[m++] = fsum[k] * fsum[l];
+      for (int k = 0; k < nfeature; k++) mine[m++] = fsum[k] * cost;
+      mine[m++] = cost;
+      mine[m++] = nlocal;
+      MPI_Allreduce(mine, all, n, MPI_DOUBLE, MPI_SUM, world);
+
+      m = 0;
+      for (int k = 0; k < nfeature; k++)
+        for (int l = 0; l < nfeature; l++) amat[k][l] = decay * amat[k][l] + all[m++];
+      for (int k = 0; k < nfeature; k++) bvec[k] = decay * bvec[k] + all[m++];
+      costsum = decay * costsum + all[m++];
+      atomsum = decay * atomsum + all[m++];
+      nsample++;
+
+      delete[] fsum;
+      delete[] mine;
+      delete[] all;
+      fit();
+    }
+  }
+
+  // no weights until there is a fit
+
+  if (nsample == 0) {
+    delete[] f;
+    return;
+  }
+
+  // weight = predicted cost of each atom, bounded from below
+
+  const double minwt = MINWT * costsum / atomsum;
+  for (int i = 0; i < nlocal; i++) {
+    features(i, f);
+    double wt = 0.0;
+    for (int k = 0; k < nfeature; k++) wt += coeff[k] * f[k];
+    weight[i] *= MAX(wt, minwt);
+  }
+
+  delete[] f;
+}
+
+/* ----------------------------------------------------------------------
+   least squares fit of feature costs to accumulated samples
+   regularized towards equal cost per atom and no cost for other features,
+     since the # of procs may be small compared to the # of features
+     or features may be correlated, e.g. all procs own similar atoms
+   negative costs are not physical and are set to zero
+------------------------------------------------------------------------- */
+
+void ImbalanceModel::fit()
+{
+  const int n = nfeature;
+  double **a;
+  memory->create(a, n, n + 1, "imbalance:a");
+
+  double percost = 0.0;
+  if (atomsum > 0.0) percost = costsum / atomsum;
+
+  for (int k = 0; k < n; k++) {
+    for (int l = 0; l < n; l++) a[k][l] = amat[k][l];
+    double ridge = RIDGE * amat[k][k];
+    if (ridge <= 0.0) ridge = RIDGE;
+    a[k][k] += ridge;
+    a[k][n] = bvec[k];
+    if (k < ntypes) a[k][n] += ridge * percost;
+  }
+
+  // Gaussian elimination with partial pivoting
+  // matrix is symmetric positive definite, so pivots are non-zero
+
+  for (int k = 0; k < n; k++) {
+    int p = k;
+    for (int l = k + 1; l < n; l++)
+      if (fabs(a[l][k]) > fabs(a[p][k])) p = l;
+    if (p != k)
+      for (int l = 0; l <= n; l++) std::swap(a[k][l], a[p][l]);
+    for (int l = k + 1; l < n; l++) {
+      double ratio = a[l][k] / a[k][k];
+      for (int m = k; m <= n; m++) a[l][m] -= ratio * a[k][m];
+    }
+  }
+
+  for (int k = n - 1; k >= 0; k--) {
+    double sum = a[k][n];
+    for (int l = k + 1; l < n; l++) sum -= a[k][l] * coeff[l];
+    coeff[k] = sum / a[k][k];
+  }
+
+  for (int k = 0; k < n; k++) coeff[k] = MAX(coeff[k], 0.0);
+
+  memory->destroy(a);
+}
+
+/* -------------------------------------------------------------------- */
+
+std::string ImbalanceModel::info()
+{
+  std::string mesg = fmt::format("  model weight decay: {} samples: {}\n", decay, nsample);
+  if (nsample == 0) return mesg;
+
+  // costs relative to the average cost per atom
+
+  const double scale = (costsum > 0.0) ? atomsum / costsum : 1.0;
+  mesg += "    type costs:";
+  for (int k = 0; k < ntypes; k++) mesg += fmt::format(" {:.4}", coeff[k] * scale);
+  mesg += fmt::format("\n    neighbor cost: {:.4}\n", coeff[ntypes] * scale);
+  for (int m = 0; m < ngroup; m++)
+    mesg += fmt::format("    group {} cost: {:.4}\n", group->names[gid[m]],
+                        coeff[ntypes + 1 + m] * scale);
+  for (int m = 0; m < nfix; m++)
+    mesg += fmt::format("    fix {} cost: {:.4}\n", fixid[m], coeff[ntypes + 1 + ngroup + m] * scale);
+  return mesg;
+}
@@ -0,0 +1,67 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_IMBALANCE_MODEL_H
+#define LMP_IMBALANCE_MODEL_H
+
+#include "imbalance.h"
+
+namespace LAMMPS_NS {
+
+class ImbalanceModel : public Imbalance {
+ public:
+  ImbalanceModel(class LAMMPS *);
+  ~ImbalanceModel() override;
+
+ public:
+  // parse options, return number of arguments consumed
+  int options(int, char **) override;
+  // reinitialize internal data
+  void init(int) override;
+  // compute and apply weight factors to local atom array
+  void compute(double *) override;
+  // print information about the state of this imbalance compute
+  std::string info() override;
+
+ private:
+  double decay;        // weight of previous samples in the fit
+  int ngroup;          // # of group membership features
+  int *gid;            // group IDs of group features
+  int nfix;            // # of fix membership features
+  char **fixid;        // fix IDs of fix features
+  int *fixbit;         // groupbit of each fix feature
+  int ntypes;          // # of atom types the model was set up for
+  int nfeature;        // # of features = ntypes + neigh count + groups + fixes
+
+  double last;         // combined wall time from last call
+  bigint laststep;     // timestep of last call, -1 if not normalizing by steps
+  int nsample;         // # of fits accumulated so far
+
+  double **amat;       // accumulated normal equations of the fit
+  double *bvec;
+  double costsum;      // accumulated total cost of all procs
+  double atomsum;      // accumulated total atom count of all procs
+  double *coeff;       // fitted cost of each feature
+
+  int maxneigh;        // allocated length of numneigh
+  int *numneigh;       // # of neighbors of each owned atom
+
+  void allocate();
+  void features(int, double *);
+  void count_neighbors();
+  void fit();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
@@ -198,18 +198,60 @@ void Irregular::migrate_atoms(int sortflag, int preassign, int *procassign)
 
   atom->nlocal = nlocal;
 
-  // create irregular communication plan, perform comm, destroy plan
-  // returned nrecv = size of buffer needed for incoming atoms
+  // with comm_modify rendezvous node, aggregate messages per node
+  //   unless the migration is sparse, see Comm::node_aggregate()
+  // work1 = # of doubles to send to each proc
+  // work2 = offset of data for each proc in sbuf ordered by proc
+  // received atoms are ordered by sending proc, so sortflag is not needed
+
+  int aggregate = 0;
+  if (comm->rvous_node) {
+    int nsendproc = 0;
+    for (i = 0; i < nprocs; i++) work1[i] = 0;
+    for (i = 0; i < nsendatom; i++) {
+      if (work1[mproclist[i]] == 0) nsendproc++;
+      work1[mproclist[i]] += msizes[i];
+    }
+    aggregate = comm->node_aggregate(nsendproc);
+  }
+
+  if (aggregate) {
+    work2[0] = 0;
+    for (i = 1; i < nprocs; i++) work2[i] = work2[i-1] + work1[i-1];
+
+    double *sbuf;
+    memory->create(sbuf,nsend+1,"irregular:sbuf");
+    int offset = 0;
+    for (i = 0; i < nsendatom; i++) {
+      memcpy(&sbuf[work2[mproclist[i]]],&buf_send[offset],msizes[i]*sizeof(double));
+      work2[mproclist[i]] += msizes[i];
+      offset += msizes[i];
+    }
+
+    char *rbuf;
+    int nrecv = comm->alltoallv_node((char *) sbuf,work1,MPI_DOUBLE,sizeof(double),rbuf,work2);
+    memory->destroy(sbuf);
 
-  int nrecv = create_atom(nsendatom,msizes,mproclist,sortflag);
-  if (nrecv > maxrecv) grow_recv(nrecv);
-  exchange_atom(buf_send,msizes,buf_recv);
-  destroy_atom();
+    auto dbuf_recv = (double *) rbuf;
+    int m = 0;
+    while (m < nrecv) m += avec->unpack_exchange(&dbuf_recv[m]);
+    memory->sfree(rbuf);
 
-  // add received atoms to my list
+  } else {
+
+    // create irregular communication plan, perform comm, destroy plan
+    // returned nrecv = size of buffer needed for incoming atoms
+
+    int nrecv = create_atom(nsendatom,msizes,mproclist,sortflag);
+    if (nrecv > maxrecv) grow_recv(nrecv);
+    exchange_atom(buf_send,msizes,buf_recv);
+    destroy_atom();
 
-  int m = 0;
-  while (m < nrecv) m += avec->unpack_exchange(&buf_recv[m]);
+    // add received atoms to my list
+
+    int m = 0;
+    while (m < nrecv) m += avec->unpack_exchange(&buf_recv[m]);
+  }
 
   // reset global->local map
 
@@ -17,7 +17,7 @@
 #define MAGIC_STRING "LammpS RestartT"
 #define ENDIAN 0x0001
 #define ENDIANSWAP 0x1000
-#define FORMAT_REVISION 3
+#define FORMAT_REVISION 4
 
 enum{VERSION,SMALLINT,TAGINT,BIGINT,
      UNITS,NTIMESTEP,DIMENSION,NPROCS,PROCGRID,
@@ -37,7 +37,7 @@ enum{VERSION,SMALLINT,TAGINT,BIGINT,
      COMM_MODE,COMM_CUTOFF,COMM_VEL,NO_PAIR,
      EXTRA_BOND_PER_ATOM,EXTRA_ANGLE_PER_ATOM,EXTRA_DIHEDRAL_PER_ATOM,
      EXTRA_IMPROPER_PER_ATOM,EXTRA_SPECIAL_PER_ATOM,ATOM_MAXSPECIAL,
-     NELLIPSOIDS,NLINES,NTRIS,NBODIES,ATIME,ATIMESTEP,LABELMAP};
+     NELLIPSOIDS,NLINES,NTRIS,NBODIES,ATIME,ATIMESTEP,LABELMAP,CHUNKMAP};
 
 #define LB_FACTOR 1.1
 
@@ -123,7 +123,10 @@ Output::~Output()
   for (int i = 0; i < ndump; i++) delete[] var_dump[i];
   memory->sfree(var_dump);
   memory->destroy(ivar_dump);
-  for (int i = 0; i < ndump; i++) delete dump[i];
+  for (int i = 0; i < ndump; i++) {
+    dump[i]->async_wait(0);
+    delete dump[i];
+  }
   memory->sfree(dump);
 
   delete[] restart1;
@@ -141,6 +144,7 @@ Output::~Output()
 void Output::init()
 {
   thermo->init();
+  if (restart) restart->async_wait();
   if (var_thermo) {
     ivar_thermo = input->variable->find(var_thermo);
     if (ivar_thermo < 0)
@@ -733,6 +737,18 @@ void Output::reset_dt()
   next = MIN(next,next_thermo);
 }
 
+/* ----------------------------------------------------------------------
+   wait for background output of all dumps and restart files to complete
+   called at end of a run, so that files are complete and errors
+     are reported before the run finishes
+------------------------------------------------------------------------- */
+
+void Output::async_wait()
+{
+  for (int idump = 0; idump < ndump; idump++) dump[idump]->async_wait();
+  if (restart) restart->async_wait();
+}
+
 /* ----------------------------------------------------------------------
    add a Dump to list of Dumps
 ------------------------------------------------------------------------- */
@@ -818,6 +834,7 @@ void Output::delete_dump(const std::string &id)
   for (idump = 0; idump < ndump; idump++) if (id == dump[idump]->id) break;
   if (idump == ndump) error->all(FLERR,"Could not find undump ID: {}", id);
 
+  dump[idump]->async_wait();
   delete dump[idump];
   delete[] var_dump[idump];
 
@@ -930,6 +947,7 @@ void Output::create_restart(int narg, char **arg)
     restart_flag = restart_flag_single = restart_flag_double = 0;
     last_restart = -1;
 
+    if (restart) restart->async_wait();
     delete restart;
     restart = nullptr;
     delete[] restart1;
@@ -1006,6 +1024,7 @@ void Output::create_restart(int narg, char **arg)
 
   // setup output style and process optional args
 
+  if (restart) restart->async_wait();
   delete restart;
   restart = new WriteRestart(lmp);
   int iarg = nfile+1;
@@ -79,6 +79,7 @@ class Output : protected Pointers {
   void write_restart(bigint);     // force output of a restart file
   void reset_timestep(bigint);    // reset output which depends on timestep
   void reset_dt();                // reset output which depends on timestep size
+  void async_wait();              // complete background output of dumps and restarts
 
   Dump *add_dump(int, char **);                       // add a Dump to Dump list
   void modify_dump(int, char **);                     // modify a Dump
@@ -28,6 +28,7 @@
 #include "math_const.h"
 #include "math_special.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neighbor.h"
 #include "suffix.h"
 #include "update.h"
@@ -59,8 +60,9 @@ Pair::Pair(LAMMPS *lmp) :
     ptable(nullptr), dptable(nullptr), vtable(nullptr), dvtable(nullptr), rdisptable(nullptr),
     drdisptable(nullptr), fdisptable(nullptr), dfdisptable(nullptr), edisptable(nullptr),
     dedisptable(nullptr), pvector(nullptr), svector(nullptr), list(nullptr), listhalf(nullptr),
-    listfull(nullptr), list_tally_compute(nullptr), elements(nullptr), elem1param(nullptr),
-    elem2param(nullptr), elem3param(nullptr), map(nullptr)
+    listfull(nullptr), list_tally_compute(nullptr), geomhost(nullptr), elements(nullptr),
+    elem1param(nullptr), elem2param(nullptr), elem3param(nullptr), map(nullptr),
+    ilist_overlap(nullptr)
 {
   instance_me = instance_total++;
 
@@ -73,6 +75,7 @@ Pair::Pair(LAMMPS *lmp) :
   single_hessian_enable = 0;
   restartinfo = 1;
   respa_enable = 0;
+  overlap_enable = 0;
   one_coeff = 0;
   no_virial_fdotr_compute = 0;
   writedata = 0;
@@ -108,6 +111,9 @@ Pair::Pair(LAMMPS *lmp) :
 
   maxeatom = maxvatom = maxcvatom = 0;
 
+  ninterior = nboundary = maxoverlap = 0;
+  overlap_ncalls = -1;
+
   num_tally_compute = 0;
   did_tally_flag = 0;
 
@@ -144,6 +150,7 @@ Pair::~Pair()
   memory->destroy(eatom);
   memory->destroy(vatom);
   memory->destroy(cvatom);
+  memory->destroy(ilist_overlap);
 }
 
 // clang-format off
@@ -2000,6 +2007,56 @@ void Pair::hessian_twobody(double fforce, double dfac, double delr[3], double ph
     }
   }
 }
+
+/* ----------------------------------------------------------------------
+   split atoms of neighbor list into interior atoms whose neighbors are
+     all owned atoms and boundary atoms with at least one ghost neighbor
+   interior atoms can be computed while ghost atom coords are in transit
+   only redone when the neighbor list was rebuilt
+------------------------------------------------------------------------- */
+
+void Pair::overlap_split(NeighList *nlist)
+{
+  if (overlap_ncalls == neighbor->ncalls) return;
+  overlap_ncalls = neighbor->ncalls;
+
+  const int inum = nlist->inum;
+  const int *const ilist = nlist->ilist;
+  const int *const numneigh = nlist->numneigh;
+  int **firstneigh = nlist->firstneigh;
+  const int nlocal = atom->nlocal;
+
+  if (inum > maxoverlap) {
+    maxoverlap = atom->nmax;
+    memory->destroy(ilist_overlap);
+    memory->create(ilist_overlap,maxoverlap,"pair:ilist_overlap");
+  }
+
+  // interior atoms are stored from the front, boundary atoms from the back
+  // and the boundary atoms are then reversed to preserve their order
+
+  int ni = 0;
+  int nb = inum;
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+    int jj;
+    for (jj = 0; jj < jnum; jj++)
+      if ((jlist[jj] & NEIGHMASK) >= nlocal) break;
+    if (jj == jnum) ilist_overlap[ni++] = i;
+    else ilist_overlap[--nb] = i;
+  }
+
+  ninterior = ni;
+  nboundary = inum - ni;
+  for (int lo = ni, hi = inum-1; lo < hi; lo++, hi--) {
+    const int tmp = ilist_overlap[lo];
+    ilist_overlap[lo] = ilist_overlap[hi];
+    ilist_overlap[hi] = tmp;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
 double Pair::memory_usage()
@@ -2007,6 +2064,7 @@ double Pair::memory_usage()
   double bytes = (double)comm->nthreads*maxeatom * sizeof(double);
   bytes += (double)comm->nthreads*maxvatom*6 * sizeof(double);
   bytes += (double)comm->nthreads*maxcvatom*9 * sizeof(double);
+  bytes += (double)maxoverlap * sizeof(int);
   return bytes;
 }
 
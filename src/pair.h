@@ -56,6 +56,7 @@ class Pair : protected Pointers {
   int single_hessian_enable;      // 1 if single_hessian() routine exists
   int restartinfo;                // 1 if pair style writes restart info
   int respa_enable;               // 1 if inner/middle/outer rRESPA routines
+  int overlap_enable;             // 1 if compute_interior/boundary() routines
   int one_coeff;                  // 1 if allows only one coeff * * call
   int manybody_flag;              // 1 if a manybody potential
   int unit_convert_flag;          // value != 0 indicates support for unit conversion.
@@ -157,6 +158,13 @@ class Pair : protected Pointers {
   virtual void compute_middle() {}
   virtual void compute_outer(int, int) {}
 
+  // split force computation to overlap it with forward comm of ghost atoms
+  // compute_interior() must not access ghost atom data
+
+  virtual void compute_interior(int, int) {}
+  virtual void compute_boundary(int, int) {}
+  void overlap_reset() { overlap_ncalls = -1; }
+
   virtual double single(int, int, int, int, double, double, double, double &fforce)
   {
     fforce = 0.0;
@@ -227,6 +235,11 @@ class Pair : protected Pointers {
   virtual void transfer_history(double *, double *, int, int) {}
   virtual double atom2cut(int) { return 0.0; }
   virtual double radii2cut(double, double) { return 0.0; }
+  virtual double **neigh_geometry(class NeighList *, int *&offset)
+  {
+    offset = nullptr;
+    return nullptr;
+  }
 
   // management of callbacks to be run from ev_tally()
 
@@ -243,6 +256,7 @@ class Pair : protected Pointers {
   int instance_me;      // which Pair class instantiation I am
   int special_lj[4];    // copied from force->special_lj for Kokkos
   int suffix_flag;      // suffix compatibility flag
+  Pair *geomhost;       // pair hybrid style sharing neighbor geometry, if any
 
   // pair_modify settings
   int offset_flag, mix_flag;    // flags for offset and mixing
@@ -281,6 +295,15 @@ class Pair : protected Pointers {
   int copymode;    // if set, do not deallocate during destruction
                    // required when classes are used as functors by Kokkos
 
+  // neighbor list ilist reordered into atoms with owned neighbors only
+  // (interior) followed by atoms with ghost neighbors (boundary)
+
+  int ninterior, nboundary;    // # of interior and boundary atoms
+  int *ilist_overlap;          // interior atom indices, then boundary atom indices
+  int maxoverlap;              // allocated length of ilist_overlap
+  bigint overlap_ncalls;       // neighbor list build the split was done for
+  void overlap_split(class NeighList *);
+
   void ev_init(int eflag, int vflag, int alloc = 1)
   {
     if (eflag || vflag)
@@ -20,6 +20,7 @@
 #include "error.h"
 #include "force.h"
 #include "memory.h"
+#include "neigh_list.h"
 #include "neigh_request.h"
 #include "neighbor.h"
 #include "pair.h"
@@ -35,12 +36,17 @@ using namespace LAMMPS_NS;
 
 PairHybrid::PairHybrid(LAMMPS *lmp) :
     Pair(lmp), styles(nullptr), cutmax_style(nullptr), keywords(nullptr), multiple(nullptr),
-    nmap(nullptr), map(nullptr), special_lj(nullptr), special_coul(nullptr), compute_tally(nullptr)
+    nmap(nullptr), map(nullptr), special_lj(nullptr), special_coul(nullptr), compute_tally(nullptr),
+    geom(nullptr)
 {
   nstyles = 0;
 
   outerflag = 0;
   respaflag = 0;
+
+  geomactive = 0;
+  geomstamp = 0;
+  ngeom = maxgeom = 0;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -66,6 +72,8 @@ PairHybrid::~PairHybrid()
 
   delete[] svector;
 
+  destroy_geometry();
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -120,6 +128,12 @@ void PairHybrid::compute(int eflag, int vflag)
     if (respa->nhybrid_styles > 0) respaflag = 1;
   }
 
+  // atom positions do not change while sub-styles are invoked,
+  // so neighbor geometry may be shared between them
+
+  geomstamp++;
+  geomactive = 1;
+
   for (m = 0; m < nstyles; m++) {
 
     set_special(m);
@@ -189,6 +203,7 @@ void PairHybrid::compute(int eflag, int vflag)
   }
 
   delete[] saved_special;
+  geomactive = 0;
 
   if (vflag_fdotr) virial_fdotr_compute();
 }
@@ -634,6 +649,12 @@ void PairHybrid::init_style()
   for (istyle = 0; istyle < nstyles; istyle++)
     if (styles[istyle]->beyond_contact) beyond_contact = 1;
 
+  // neighbor lists will be re-created, so discard cached geometry
+  // sub-styles request shared geometry from this style in their compute()
+
+  destroy_geometry();
+  for (istyle = 0; istyle < nstyles; istyle++) styles[istyle]->geomhost = this;
+
   // each sub-style makes its neighbor list request(s)
 
   for (istyle = 0; istyle < nstyles; istyle++) styles[istyle]->init_style();
@@ -1218,5 +1239,128 @@ double PairHybrid::memory_usage()
   bytes += (double)maxvatom*6 * sizeof(double);
   bytes += (double)maxcvatom*9 * sizeof(double);
   for (int m = 0; m < nstyles; m++) bytes += styles[m]->memory_usage();
+  for (int n = 0; n < ngeom; n++) {
+    bytes += (double)geom[n].maxatom * sizeof(int);
+    bytes += (double)geom[n].maxneigh*4 * sizeof(double);
+  }
   return bytes;
 }
+
+/* ----------------------------------------------------------------------
+   return displacements xi - xj and squared distances for all I,J pairs
+     of a neighbor list, so that sub-styles using the same list do not
+     each have to recompute them
+   dr[offset[ii]+jj] = delx,dely,delz,rsq for jj-th neighbor of ilist[ii]
+   data is only computed if the list was requested by more than one
+     sub-style in the previous invocation of compute(),
+     otherwise return nullptr and the sub-style computes the geometry itself
+------------------------------------------------------------------------- */
+
+double **PairHybrid::neigh_geometry(NeighList *nlist, int *&offset)
+{
+  offset = nullptr;
+  if (!geomactive || !nlist) return nullptr;
+
+  // copy lists share the neighbor data of the list they copy from
+
+  while (nlist->copy && !nlist->trim && !nlist->kk2cpu && nlist->listcopy)
+    nlist = nlist->listcopy;
+
+  int n;
+  for (n = 0; n < ngeom; n++)
+    if (geom[n].list == nlist) break;
+
+  if (n == ngeom) {
+    if (ngeom == maxgeom) {
+      maxgeom += 4;
+      geom = (NeighGeometry *)
+        memory->srealloc(geom,maxgeom*sizeof(NeighGeometry),"pair:geom");
+    }
+    geom[n].list = nlist;
+    geom[n].stamp = -1;
+    geom[n].nuser = geom[n].nuser_last = 0;
+    geom[n].valid = 0;
+    geom[n].maxatom = geom[n].maxneigh = 0;
+    geom[n].offset = nullptr;
+    geom[n].dr = nullptr;
+    ngeom++;
+  }
+
+  NeighGeometry &g = geom[n];
+  if (g.stamp != geomstamp) {
+    g.stamp = geomstamp;
+    g.nuser_last = g.nuser;
+    g.nuser = 0;
+    g.valid = 0;
+  }
+  g.nuser++;
+
+  if (g.nuser_last < 2) return nullptr;
+
+  if (!g.valid) {
+    const int inum = nlist->inum;
+    int *ilist = nlist->ilist;
+    int *numneigh = nlist->numneigh;
+    int **firstneigh = nlist->firstneigh;
+    double **x = atom->x;
+
+    if (inum > g.maxatom) {
+      g.maxatom = atom->nmax;
+      memory->destroy(g.offset);
+      memory->create(g.offset,g.maxatom,"pair:geom:offset");
+    }
+
+    int ntotal = 0;
+    for (int ii = 0; ii < inum; ii++) {
+      g.offset[ii] = ntotal;
+      ntotal += numneigh[ilist[ii]];
+    }
+
+    if (ntotal > g.maxneigh) {
+      g.maxneigh = ntotal + ntotal/10;
+      memory->destroy(g.dr);
+      memory->create(g.dr,g.maxneigh,4,"pair:geom:dr");
+    }
+
+    for (int ii = 0; ii < inum; ii++) {
+      const int i = ilist[ii];
+      const double xtmp = x[i][0];
+      const double ytmp = x[i][1];
+      const double ztmp = x[i][2];
+      const int *jlist = firstneigh[i];
+      const int jnum = numneigh[i];
+      double **dr = g.dr + g.offset[ii];
+
+      for (int jj = 0; jj < jnum; jj++) {
+        const int j = jlist[jj] & NEIGHMASK;
+        const double delx = xtmp - x[j][0];
+        const double dely = ytmp - x[j][1];
+        const double delz = ztmp - x[j][2];
+        dr[jj][0] = delx;
+        dr[jj][1] = dely;
+        dr[jj][2] = delz;
+        dr[jj][3] = delx*delx + dely*dely + delz*delz;
+      }
+    }
+    g.valid = 1;
+  }
+
+  if (g.maxneigh == 0) return nullptr;
+  offset = g.offset;
+  return g.dr;
+}
+
+/* ----------------------------------------------------------------------
+   free all cached neighbor geometry data
+------------------------------------------------------------------------- */
+
+void PairHybrid::destroy_geometry()
+{
+  for (int n = 0; n < ngeom; n++) {
+    memory->destroy(geom[n].offset);
+    memory->destroy(geom[n].dr);
+  }
+  memory->sfree(geom);
+  geom = nullptr;
+  ngeom = maxgeom = 0;
+}
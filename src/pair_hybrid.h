@@ -69,6 +69,8 @@ class PairHybrid : public Pair {
   double atom2cut(int) override;
   double radii2cut(double, double) override;
 
+  double **neigh_geometry(class NeighList *, int *&) override;
+
  protected:
   int nstyles;             // # of sub-styles
   Pair **styles;           // list of Pair style classes
@@ -86,8 +88,27 @@ class PairHybrid : public Pair {
   double **special_coul;    // list of per style Coulomb exclusion factors
   int *compute_tally;       // list of on/off flags for tally computes
 
+  // per-neighbor displacements and distances shared between sub-styles
+
+  struct NeighGeometry {
+    class NeighList *list;    // neighbor list the data belongs to
+    bigint stamp;             // invocation of compute() the data belongs to
+    int nuser;                // # of requests during this invocation
+    int nuser_last;           // # of requests during previous invocation
+    int valid;                // 1 if data is current
+    int maxatom, maxneigh;    // allocated sizes of offset and dr
+    int *offset;              // index into dr of 1st neighbor of each I atom
+    double **dr;              // delx,dely,delz,rsq for each I,J pair
+  };
+
+  int geomactive;           // 1 while sub-styles are invoked from compute()
+  bigint geomstamp;         // counts invocations of compute()
+  int ngeom, maxgeom;       // # of used/allocated geometry entries
+  NeighGeometry *geom;      // geometry data for each neighbor list
+
   void allocate();
   void flags();
+  void destroy_geometry();
 
   virtual void init_svector();
   virtual void copy_svector(int, int);
@@ -39,6 +39,7 @@ using namespace MathConst;
 PairLJCut::PairLJCut(LAMMPS *lmp) : Pair(lmp)
 {
   respa_enable = 1;
+  overlap_enable = 1;
   born_matrix_enable = 1;
   writedata = 1;
 }
@@ -68,13 +69,49 @@ PairLJCut::~PairLJCut()
 
 void PairLJCut::compute(int eflag, int vflag)
 {
-  int i, j, ii, jj, inum, jnum, itype, jtype;
+  ev_init(eflag, vflag);
+
+  compute_atoms(eflag, list->ilist, list->inum);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   compute forces of atoms with only owned neighbors
+   ghost atom coords may not yet be current
+------------------------------------------------------------------------- */
+
+void PairLJCut::compute_interior(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  overlap_split(list);
+  compute_atoms(eflag, ilist_overlap, ninterior);
+}
+
+/* ----------------------------------------------------------------------
+   compute forces of remaining atoms after ghost atom coords are current
+------------------------------------------------------------------------- */
+
+void PairLJCut::compute_boundary(int eflag, int /*vflag*/)
+{
+  compute_atoms(eflag, ilist_overlap + ninterior, nboundary);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   compute forces for the inum atoms in ilist
+------------------------------------------------------------------------- */
+
+void PairLJCut::compute_atoms(int eflag, int *ilist, int inum)
+{
+  int i, j, ii, jj, jnum, itype, jtype;
   double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
   double rsq, r2inv, r6inv, forcelj, factor_lj;
-  int *ilist, *jlist, *numneigh, **firstneigh;
+  int *jlist, *numneigh, **firstneigh;
 
   evdwl = 0.0;
-  ev_init(eflag, vflag);
 
   double **x = atom->x;
   double **f = atom->f;
@@ -83,8 +120,6 @@ void PairLJCut::compute(int eflag, int vflag)
   double *special_lj = force->special_lj;
   int newton_pair = force->newton_pair;
 
-  inum = list->inum;
-  ilist = list->ilist;
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
@@ -134,8 +169,6 @@ void PairLJCut::compute(int eflag, int vflag)
       }
     }
   }
-
-  if (vflag_fdotr) virial_fdotr_compute();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -29,6 +29,8 @@ class PairLJCut : public Pair {
   PairLJCut(class LAMMPS *);
   ~PairLJCut() override;
   void compute(int, int) override;
+  void compute_interior(int, int) override;
+  void compute_boundary(int, int) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
   void init_style() override;
@@ -55,6 +57,7 @@ class PairLJCut : public Pair {
   double *cut_respa;
 
   virtual void allocate();
+  void compute_atoms(int, int *, int);
 };
 
 }    // namespace LAMMPS_NS
@@ -74,6 +74,8 @@ void PairZBL::compute(int eflag, int vflag)
   double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
   double rsq, r, t, fswitch, eswitch;
   int *ilist, *jlist, *numneigh, **firstneigh;
+  int *geomoffset;
+  double **geom, **dr;
 
   evdwl = 0.0;
   ev_init(eflag, vflag);
@@ -89,6 +91,11 @@ void PairZBL::compute(int eflag, int vflag)
   numneigh = list->numneigh;
   firstneigh = list->firstneigh;
 
+  // reuse neighbor geometry if shared with other pair hybrid sub-styles
+
+  geom = geomhost ? geomhost->neigh_geometry(list, geomoffset) : nullptr;
+  dr = nullptr;
+
   // loop over neighbors of my atoms
 
   for (ii = 0; ii < inum; ii++) {
@@ -99,15 +106,23 @@ void PairZBL::compute(int eflag, int vflag)
     itype = type[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
+    if (geom) dr = geom + geomoffset[ii];
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
       j &= NEIGHMASK;
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx * delx + dely * dely + delz * delz;
+      if (dr) {
+        delx = dr[jj][0];
+        dely = dr[jj][1];
+        delz = dr[jj][2];
+        rsq = dr[jj][3];
+      } else {
+        delx = xtmp - x[j][0];
+        dely = ytmp - x[j][1];
+        delz = ztmp - x[j][2];
+        rsq = delx * delx + dely * dely + delz * delz;
+      }
       jtype = type[j];
 
       if (rsq < cut_globalsq) {
@@ -154,6 +154,8 @@ void ReadData::command(int narg, char **arg)
       extra_improper_types = 0;
 
   groupbit = 0;
+  parallelflag = 0;
+  datafile = arg[0];
 
   nfix = 0;
   fix_index = nullptr;
@@ -300,6 +302,10 @@ void ReadData::command(int narg, char **arg)
       int igroup = group->find_or_create(arg[iarg + 1]);
       groupbit = group->bitmask[igroup];
       iarg += 2;
+    } else if (strcmp(arg[iarg], "parallel") == 0) {
+      if (iarg + 2 > narg) utils::missing_cmd_args(FLERR, "read_data parallel", error);
+      parallelflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
     } else if (strcmp(arg[iarg], "fix") == 0) {
       if (iarg + 4 > narg) utils::missing_cmd_args(FLERR, "read_data fix", error);
       fix_index =
@@ -332,6 +338,8 @@ void ReadData::command(int narg, char **arg)
 
   // error checks
 
+  if (parallelflag && (addflag != NONE))
+    error->all(FLERR, "Read_data parallel yes cannot be used with add keyword");
   if ((domain->dimension == 2) && (domain->zperiodic == 0))
     error->all(FLERR, "Cannot run 2d simulation with nonperiodic Z dimension");
   if ((domain->nonperiodic == 2) && utils::strmatch(force->kspace_style, "^msm"))
@@ -1399,17 +1407,30 @@ void ReadData::atoms()
 
   if (me == 0) utils::logmesg(lmp, "  reading atoms ...\n");
 
-  bigint nread = 0;
+  // parallel reads require random access, so not possible for compressed files
 
-  while (nread < natoms) {
-    nchunk = MIN(natoms - nread, CHUNK);
-    eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
-    if (eof) error->all(FLERR, "Unexpected end of data file");
-    if (tlabelflag && !lmap->is_complete(Atom::ATOM))
-      error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
-    atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift, tlabelflag,
-                     lmap->lmap2lmap.atom);
-    nread += nchunk;
+  int pflag = parallelflag && !compressed;
+  MPI_Bcast(&pflag, 1, MPI_INT, 0, world);
+  if (parallelflag && !pflag && (me == 0))
+    error->warning(FLERR, "Cannot read Atoms section of compressed data file in parallel");
+
+  if (pflag) {
+    atoms_parallel();
+
+  } else {
+    bigint nread = 0;
+
+    while (nread < natoms) {
+      nchunk = MIN(natoms - nread, CHUNK);
+      eof = utils::read_lines_from_file(fp, nchunk, MAXLINE, buffer, me, world);
+      if (eof) error->all(FLERR, "Unexpected end of data file");
+      if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+        error->all(FLERR,
+                   "Label map is incomplete: all types must be assigned a unique type label");
+      atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift,
+                       tlabelflag, lmap->lmap2lmap.atom);
+      nread += nchunk;
+    }
   }
 
   // warn if we have read data with non-zero image flags for non-periodic boundaries.
@@ -1458,6 +1479,124 @@ void ReadData::atoms()
   }
 }
 
+/* ----------------------------------------------------------------------
+   read all atoms in parallel
+   the bytes from the start of the section to the end of the file are split
+     evenly across procs, a line belongs to the proc whose share contains
+     its first character
+   the section ends at the first blank line or the end of the file,
+     each proc looks for it in its share, so no proc scans the whole section
+   each proc then parses its lines before the end of the section,
+     keeping all atoms inside the box, then atoms migrate to owning procs
+------------------------------------------------------------------------- */
+
+void ReadData::atoms_parallel()
+{
+  if (tlabelflag && !lmap->is_complete(Atom::ATOM))
+    error->all(FLERR, "Label map is incomplete: all types must be assigned a unique type label");
+
+  bigint offsets[2];
+  if (me == 0) {
+    offsets[0] = platform::ftell(fp);
+    platform::fseek(fp, platform::END_OF_FILE);
+    offsets[1] = platform::ftell(fp);
+  }
+  MPI_Bcast(offsets, 2, MPI_LMP_BIGINT, 0, world);
+
+  int nprocs = comm->nprocs;
+  bigint length = offsets[1] - offsets[0];
+  bigint lo = offsets[0] + static_cast<bigint>((double) length * me / nprocs);
+  bigint hi = offsets[0] + static_cast<bigint>((double) length * (me + 1) / nprocs);
+  if (me == nprocs - 1) hi = offsets[1];
+
+  // skip remainder of line that straddles my lower bound
+  // first = offset of first line starting in my share
+
+  FILE *pfp = nullptr;
+  bigint first = lo;
+  if (hi > lo) {
+    pfp = fopen(datafile.c_str(), "r");
+    if (!pfp) error->one(FLERR, "Cannot open file {}: {}", datafile, utils::getsyserror());
+    if (me > 0) {
+      platform::fseek(pfp, lo - 1);
+      if (!utils::fgets_trunc(line, MAXLINE, pfp)) error->one(FLERR, "Unexpected end of data file");
+      first = platform::ftell(pfp);
+    }
+  }
+
+  // find offset of first blank line in my share, end of file if none
+  // end of section is the first one across all procs
+
+  bigint pos = first;
+  bigint myend = offsets[1];
+  if (pfp) platform::fseek(pfp, first);
+  while (pos < hi) {
+    if (!utils::fgets_trunc(line, MAXLINE, pfp)) break;
+    if (utils::trim(line).empty()) {
+      myend = pos;
+      break;
+    }
+    pos = platform::ftell(pfp);
+  }
+
+  bigint sectionend;
+  MPI_Allreduce(&myend, &sectionend, 1, MPI_LMP_BIGINT, MPI_MIN, world);
+  hi = MIN(hi, sectionend);
+
+  // read and parse my lines in chunks
+
+  bigint nlines = 0;
+  int nchunk = 0;
+  int m = 0;
+  pos = first;
+  if (pfp) platform::fseek(pfp, first);
+  while (pos < hi) {
+    if (!utils::fgets_trunc(&buffer[m], MAXLINE, pfp))
+      error->one(FLERR, "Unexpected end of data file");
+    m += strlen(&buffer[m]);
+    nchunk++;
+    nlines++;
+    pos = platform::ftell(pfp);
+    if ((nchunk == CHUNK) || (pos >= hi)) {
+      atom->data_atoms(nchunk, buffer, id_offset, mol_offset, toffset, shiftflag, shift,
+                       tlabelflag, lmap->lmap2lmap.atom, 1);
+      nchunk = m = 0;
+    }
+  }
+  if (pfp) fclose(pfp);
+
+  bigint nall;
+  MPI_Allreduce(&nlines, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  if (nall != natoms)
+    error->all(FLERR, "Atoms section has {} lines instead of {} before next blank line",
+               nall, natoms);
+
+  // continue reading the data file after the section
+
+  if (me == 0) platform::fseek(fp, sectionend);
+
+  // combine flags for image flags reset by any proc
+
+  int flag[3], flagall[3];
+  for (int i = 0; i < 3; i++) flag[i] = atom->reset_image_flag[i] ? 1 : 0;
+  MPI_Allreduce(flag, flagall, 3, MPI_INT, MPI_MAX, world);
+  for (int i = 0; i < 3; i++) atom->reset_image_flag[i] = flagall[i] != 0;
+
+  // move atoms to the procs owning their sub-domains
+  // first do map_init() since irregular->migrate_atoms() will do map_clear()
+
+  if (atom->map_style != Atom::MAP_NONE) {
+    atom->map_init();
+    atom->map_set();
+  }
+
+  if (domain->triclinic) domain->x2lamda(atom->nlocal);
+  auto irregular = new Irregular(lmp);
+  irregular->migrate_atoms(1);
+  delete irregular;
+  if (domain->triclinic) domain->lamda2x(atom->nlocal);
+}
+
 /* ----------------------------------------------------------------------
    read all velocities
    to find atoms, must build atom map if not a molecular system
@@ -75,6 +75,8 @@ class ReadData : public Command {
   int extra_atom_types, extra_bond_types, extra_angle_types;
   int extra_dihedral_types, extra_improper_types;
   int groupbit;
+  int parallelflag;
+  std::string datafile;
 
   int nfix;
   Fix **fix_index;
@@ -93,6 +95,7 @@ class ReadData : public Command {
   int style_match(const char *, const char *);
 
   void atoms();
+  void atoms_parallel();
   void velocities();
 
   void bonds(int);
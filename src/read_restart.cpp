@@ -43,7 +43,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-ReadRestart::ReadRestart(LAMMPS *lmp) : Command(lmp), mpiio(nullptr) {}
+ReadRestart::ReadRestart(LAMMPS *lmp) :
+    Command(lmp), chunkflag(0), chunk_sizes(nullptr), chunk_bbox(nullptr), mpiio(nullptr)
+{
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -204,6 +207,84 @@ void ReadRestart::command(int narg, char **arg)
     while (m < assignedChunkSize) m += avec->unpack_restart(&buf[m]);
   }
 
+  // input of single native file with chunk map
+  // each proc opens the file and reads only the chunks whose atom
+  //   bounding box overlaps its sub-domain
+  // each proc unpacks the atoms, saving ones in its sub-domain
+  // without remap the chunk bounding boxes cannot exclude any chunk,
+  //   so use the proc 0 read and broadcast below instead
+
+  else if (multiproc == 0 && chunkflag && remapflag) {
+
+    int triclinic = domain->triclinic;
+    imageint *iptr;
+    double *x,lamda[3];
+    double *coord,*sublo,*subhi;
+    if (triclinic == 0) {
+      sublo = domain->sublo;
+      subhi = domain->subhi;
+    } else {
+      sublo = domain->sublo_lamda;
+      subhi = domain->subhi_lamda;
+    }
+
+    if (me) {
+      fp = fopen(file,"rb");
+      if (fp == nullptr)
+        error->one(FLERR,"Cannot open restart file {}: {}", file, utils::getsyserror());
+    }
+
+    bigint offset = chunk_offset;
+    for (int iproc = 0; iproc < nprocs_file; iproc++) {
+      n = chunk_sizes[iproc];
+      double *bbox = &chunk_bbox[6*iproc];
+      bigint chunk = offset;
+      offset += 2*sizeof(int) + (bigint) n*sizeof(double);
+
+      if (bbox[0] >= subhi[0] || bbox[1] < sublo[0] ||
+          bbox[2] >= subhi[1] || bbox[3] < sublo[1] ||
+          bbox[4] >= subhi[2] || bbox[5] < sublo[2]) continue;
+
+      platform::fseek(fp,chunk);
+      utils::sfread(FLERR,&flag,sizeof(int),1,fp,nullptr,error);
+      if (flag != PERPROC)
+        error->one(FLERR,"Invalid flag in peratom section of restart file");
+      utils::sfread(FLERR,&m,sizeof(int),1,fp,nullptr,error);
+      if (m != n)
+        error->one(FLERR,"Inconsistent chunk size in peratom section of restart file");
+
+      if (n > maxbuf) {
+        maxbuf = n;
+        memory->destroy(buf);
+        memory->create(buf,maxbuf,"read_restart:buf");
+      }
+      utils::sfread(FLERR,buf,sizeof(double),n,fp,nullptr,error);
+
+      m = 0;
+      while (m < n) {
+        x = &buf[m+1];
+        iptr = (imageint *) &buf[m+7];
+        domain->remap(x,*iptr);
+
+        if (triclinic) {
+          domain->x2lamda(x,lamda);
+          coord = lamda;
+        } else coord = x;
+
+        if (coord[0] >= sublo[0] && coord[0] < subhi[0] &&
+            coord[1] >= sublo[1] && coord[1] < subhi[1] &&
+            coord[2] >= sublo[2] && coord[2] < subhi[2]) {
+          m += avec->unpack_restart(&buf[m]);
+        } else m += static_cast<int> (buf[m]);
+      }
+    }
+
+    fclose(fp);
+    fp = nullptr;
+    memory->destroy(chunk_sizes);
+    memory->destroy(chunk_bbox);
+  }
+
   // input of single native file
   // nprocs_file = # of chunks in file
   // proc 0 reads a chunk and bcasts it to other procs
@@ -262,6 +343,8 @@ void ReadRestart::command(int narg, char **arg)
       fclose(fp);
       fp = nullptr;
     }
+    memory->destroy(chunk_sizes);
+    memory->destroy(chunk_bbox);
   }
 
   // input of multiple native files with procs <= files
@@ -1094,11 +1177,28 @@ void ReadRestart::file_layout()
         memory->destroy(nproc_chunk_sizes);
         memory->destroy(nproc_chunk_offsets);
       }
+
+    } else if (flag == CHUNKMAP) {
+      int nchunk = read_int();
+      if (nchunk != nprocs_file)
+        error->all(FLERR,"Invalid chunk map in restart file");
+      memory->create(chunk_sizes,nchunk,"read_restart:chunk_sizes");
+      memory->create(chunk_bbox,6*nchunk,"read_restart:chunk_bbox");
+      read_int_vec(nchunk,chunk_sizes);
+      read_double_vec(6*nchunk,chunk_bbox);
+      chunkflag = 1;
     }
 
     flag = read_int();
   }
 
+  // if file has chunk map, broadcast offset of first per-proc chunk
+
+  if (chunkflag) {
+    if (me == 0) chunk_offset = platform::ftell(fp);
+    MPI_Bcast(&chunk_offset,1,MPI_LMP_BIGINT,0,world);
+  }
+
   // if MPI-IO file, broadcast the end of the header offset
   // this allows all ranks to compute offset to their data
 
@@ -39,6 +39,13 @@ class ReadRestart : public Command {
   int nprocs_file;       // total # of procs that wrote restart file
   int revision;          // revision number of the restart file format
 
+  // per-proc chunk map of single native file
+
+  int chunkflag;            // 1 if file has chunk map, else 0
+  int *chunk_sizes;         // # of doubles in each per-proc chunk
+  double *chunk_bbox;       // bounding box of atoms in each chunk
+  bigint chunk_offset;      // file offset of first per-proc chunk
+
   // MPI-IO values
 
   int mpiioflag;                // 1 for MPIIO output, else 0
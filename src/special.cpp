@@ -24,6 +24,11 @@
 #include "memory.h"
 #include "modify.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
 using namespace LAMMPS_NS;
 
 #define RVOUS 1   // 0 for irregular, 1 for all2all
@@ -177,6 +182,266 @@ void Special::build()
   timer_output(time1);
 }
 
+/* ----------------------------------------------------------------------
+   update 1-2, 1-3, 1-4 lists after bonds were added to the system
+   npair = # of new bonds this proc added, pairs = their 2*npair atom IDs
+   only atoms within 2 bonds of a new bond have changed lists,
+     recompute them from the 1-2 lists of atoms within 4 bonds
+   use build() instead when 1-3, 1-4 are trimmed, 1-5 are stored,
+     a fix alters special lists, or the lists were not up-to-date before
+------------------------------------------------------------------------- */
+
+void Special::update(int npair, tagint *pairs)
+{
+  int flag = 0;
+  if (force->special_onefive || force->special_angle || force->special_dihedral) flag = 1;
+  if ((atom->molecular != Atom::MOLECULAR) || lmp->kokkos) flag = 1;
+  for (const auto &ifix : modify->get_fix_list())
+    if (ifix->special_alter_flag) flag = 1;
+  if (flag) {
+    build();
+    return;
+  }
+
+  MPI_Barrier(world);
+  double time1 = platform::walltime();
+
+  // gather new bonds from all procs and check current lists against bond count
+
+  int nall;
+  tagint *allpairs;
+  if (!update_check(npair,pairs,nall,allpairs)) {
+    memory->destroy(allpairs);
+    build();
+    return;
+  }
+
+  // depth = 1,2,3 if lists store 1-2, 1-3, 1-4 neighbors, same as in build()
+
+  int depth = 3;
+  if (force->special_lj[3] == 1.0 && force->special_coul[3] == 1.0) {
+    depth = 2;
+    if (force->special_lj[2] == 1.0 && force->special_coul[2] == 1.0) depth = 1;
+  }
+
+  int nupdate = update_lists(depth,nall,allpairs);
+  memory->destroy(allpairs);
+
+  if (nupdate < 0) {
+    build();
+    return;
+  }
+
+  if (me == 0)
+    utils::logmesg(lmp,"Updated 1-2 1-3 1-4 neighbors of {} atoms for {} new bonds\n",
+                   nupdate,nall);
+  timer_output(time1);
+}
+
+/* ----------------------------------------------------------------------
+   gather nall unique new bonds in pairs of all procs into allpairs
+   return 1 if 1-2 lists match the bonds before they were added, else 0
+------------------------------------------------------------------------- */
+
+int Special::update_check(int npair, tagint *pairs, int &nall, tagint *&allpairs)
+{
+  int *recvcounts,*displs;
+  memory->create(recvcounts,nprocs,"special:recvcounts");
+  memory->create(displs,nprocs,"special:displs");
+
+  int nsend = 2*npair;
+  MPI_Allgather(&nsend,1,MPI_INT,recvcounts,1,MPI_INT,world);
+  displs[0] = 0;
+  for (int iproc = 1; iproc < nprocs; iproc++)
+    displs[iproc] = displs[iproc-1] + recvcounts[iproc-1];
+  int ntotal = displs[nprocs-1] + recvcounts[nprocs-1];
+
+  memory->create(allpairs,MAX(ntotal,1),"special:allpairs");
+  MPI_Allgatherv(pairs,nsend,MPI_LMP_TAGINT,allpairs,recvcounts,displs,MPI_LMP_TAGINT,world);
+  memory->destroy(recvcounts);
+  memory->destroy(displs);
+
+  // order each pair by atom ID and remove pairs reported by multiple procs
+
+  std::set<std::pair<tagint,tagint>> unique;
+  for (int i = 0; i < ntotal; i += 2)
+    unique.insert(std::make_pair(MIN(allpairs[i],allpairs[i+1]),MAX(allpairs[i],allpairs[i+1])));
+  nall = 0;
+  for (const auto &ipair : unique) {
+    allpairs[nall++] = ipair.first;
+    allpairs[nall++] = ipair.second;
+  }
+  nall /= 2;
+
+  // each bond contributes to the 1-2 lists of both its atoms
+  // a mismatch means duplicate bonds or lists that were not updated
+
+  int **nspecial = atom->nspecial;
+  int nlocal = atom->nlocal;
+
+  bigint n12 = 0;
+  for (int i = 0; i < nlocal; i++) n12 += nspecial[i][0];
+  bigint alln12;
+  MPI_Allreduce(&n12,&alln12,1,MPI_LMP_BIGINT,MPI_SUM,world);
+
+  return (alln12 + 2*nall == 2*atom->nbonds) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   recompute special lists of owned atoms within depth-1 bonds of a new bond
+   gather 1-2 lists of all atoms within 2*depth-2 bonds on all procs,
+     one bond distance at a time, starting from the new bond atoms
+   return # of atoms with updated lists,
+     -1 if more atoms are involved than a proc owns on average,
+     or if a list would exceed atom->maxspecial
+------------------------------------------------------------------------- */
+
+int Special::update_lists(int depth, int nall, tagint *allpairs)
+{
+  int i,j,m;
+
+  int **nspecial = atom->nspecial;
+  tagint **special = atom->special;
+  int nlocal = atom->nlocal;
+
+  std::map<tagint,std::vector<tagint>> partners;
+  std::map<tagint,int> distance;
+  std::vector<tagint> frontier,sendbuf,recvbuf;
+
+  for (i = 0; i < 2*nall; i++)
+    if (distance.count(allpairs[i]) == 0) {
+      distance[allpairs[i]] = 0;
+      frontier.push_back(allpairs[i]);
+    }
+
+  int *recvcounts,*displs;
+  memory->create(recvcounts,nprocs,"special:recvcounts");
+  memory->create(displs,nprocs,"special:displs");
+
+  bigint maxinvolved = MAX(atom->natoms/nprocs,1);
+
+  for (int hop = 0; hop <= 2*depth-2; hop++) {
+
+    // records of owned atoms in frontier: atom ID, # of 1-2 neighs, 1-2 neighs
+
+    sendbuf.clear();
+    for (auto id : frontier) {
+      m = atom->map(id);
+      if (m < 0 || m >= nlocal) continue;
+      sendbuf.push_back(id);
+      sendbuf.push_back(nspecial[m][0]);
+      for (j = 0; j < nspecial[m][0]; j++) sendbuf.push_back(special[m][j]);
+    }
+
+    int nsend = sendbuf.size();
+    MPI_Allgather(&nsend,1,MPI_INT,recvcounts,1,MPI_INT,world);
+    displs[0] = 0;
+    for (int iproc = 1; iproc < nprocs; iproc++)
+      displs[iproc] = displs[iproc-1] + recvcounts[iproc-1];
+    recvbuf.resize(MAX(displs[nprocs-1] + recvcounts[nprocs-1],1));
+    MPI_Allgatherv(sendbuf.data(),nsend,MPI_LMP_TAGINT,recvbuf.data(),recvcounts,displs,
+                   MPI_LMP_TAGINT,world);
+
+    int nrecv = displs[nprocs-1] + recvcounts[nprocs-1];
+    for (i = 0; i < nrecv; i += 2 + recvbuf[i+1])
+      partners[recvbuf[i]].assign(&recvbuf[i+2],&recvbuf[i+2] + recvbuf[i+1]);
+
+    // add new bonds to 1-2 lists of their atoms, all are in the 1st frontier
+
+    if (hop == 0)
+      for (i = 0; i < 2*nall; i += 2) {
+        partners[allpairs[i]].push_back(allpairs[i+1]);
+        partners[allpairs[i+1]].push_back(allpairs[i]);
+      }
+
+    if (hop == 2*depth-2) break;
+
+    std::vector<tagint> next;
+    for (auto id : frontier)
+      for (auto partner : partners[id])
+        if (distance.count(partner) == 0) {
+          distance[partner] = hop+1;
+          next.push_back(partner);
+        }
+    frontier.swap(next);
+
+    // same decision on all procs since all have the same distance map
+
+    if ((bigint) distance.size() > maxinvolved) {
+      memory->destroy(recvcounts);
+      memory->destroy(displs);
+      return -1;
+    }
+  }
+
+  memory->destroy(recvcounts);
+  memory->destroy(displs);
+
+  // new lists for owned atoms within depth-1 bonds of a new bond
+  // 1-3 = 1-2 of 1-2, 1-4 = 1-2 of 1-3, each without self and earlier lists,
+  //   the same as built by onethree_build(), onefour_build(), dedup(), combine()
+
+  std::vector<int> updated;
+  std::vector<tagint> lists;
+  std::vector<int> counts;
+  int overflow = 0;
+
+  for (const auto &idist : distance) {
+    if (idist.second > depth-1) continue;
+    m = atom->map(idist.first);
+    if (m < 0 || m >= nlocal) continue;
+
+    tagint itag = idist.first;
+    const auto &ionetwo = partners[itag];
+    std::set<tagint> seen;
+    seen.insert(itag);
+    int nfirst = lists.size();
+
+    for (auto jtag : ionetwo)
+      if (seen.insert(jtag).second) lists.push_back(jtag);
+    counts.push_back(lists.size() - nfirst);
+
+    if (depth > 1)
+      for (auto jtag : ionetwo)
+        for (auto ktag : partners[jtag])
+          if ((ktag != itag) && seen.insert(ktag).second) lists.push_back(ktag);
+    counts.push_back(lists.size() - nfirst);
+
+    if (depth > 2)
+      for (auto jtag : ionetwo)
+        for (auto ktag : partners[jtag]) {
+          if (ktag == itag) continue;
+          for (auto ltag : partners[ktag])
+            if (seen.insert(ltag).second) lists.push_back(ltag);
+        }
+    counts.push_back(lists.size() - nfirst);
+
+    if (counts.back() > atom->maxspecial) overflow = 1;
+    updated.push_back(m);
+  }
+
+  int overflow_all;
+  MPI_Allreduce(&overflow,&overflow_all,1,MPI_INT,MPI_MAX,world);
+  if (overflow_all) return -1;
+
+  // store new lists, nspecial holds cumulative counters
+
+  int nfirst = 0;
+  for (i = 0; i < (int) updated.size(); i++) {
+    m = updated[i];
+    nspecial[m][0] = counts[3*i];
+    nspecial[m][1] = counts[3*i+1];
+    nspecial[m][2] = counts[3*i+2];
+    for (j = 0; j < nspecial[m][2]; j++) special[m][j] = lists[nfirst+j];
+    nfirst += nspecial[m][2];
+  }
+
+  int nupdate = updated.size();
+  int nupdate_all;
+  MPI_Allreduce(&nupdate,&nupdate_all,1,MPI_INT,MPI_SUM,world);
+  return nupdate_all;
+}
+
 /* ----------------------------------------------------------------------
    setup atomIDs and procowner
 ------------------------------------------------------------------------- */
@@ -23,6 +23,7 @@ class Special : protected Pointers {
   Special(class LAMMPS *);
   ~Special() override;
   void build();
+  void update(int, tagint *);
 
  private:
   int me, nprocs;
@@ -61,6 +62,9 @@ class Special : protected Pointers {
   void fix_alteration();
   void timer_output(double);
 
+  int update_check(int, tagint *, int &, tagint *&);
+  int update_lists(int, int, tagint *);
+
   // callback functions for rendezvous communication
 
   static int rendezvous_ids(int, char *, int &, int *&, char *&, void *);
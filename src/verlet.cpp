@@ -40,7 +40,7 @@ using namespace LAMMPS_NS;
 /* ---------------------------------------------------------------------- */
 
 Verlet::Verlet(LAMMPS *lmp, int narg, char **arg) :
-  Integrate(lmp, narg, arg) {}
+  Integrate(lmp, narg, arg), overlapflag(0) {}
 
 /* ----------------------------------------------------------------------
    initialization before run
@@ -136,6 +136,7 @@ void Verlet::setup(int flag)
   ev_set(update->ntimestep);
   force_clear();
   modify->setup_pre_force(vflag);
+  overlap_setup();
 
   if (pair_compute_flag) force->pair->compute(eflag,vflag);
   else if (force->pair) force->pair->compute_dummy(eflag,vflag);
@@ -198,6 +199,7 @@ void Verlet::setup_minimal(int flag)
   ev_set(update->ntimestep);
   force_clear();
   modify->setup_pre_force(vflag);
+  overlap_setup();
 
   if (pair_compute_flag) force->pair->compute(eflag,vflag);
   else if (force->pair) force->pair->compute_dummy(eflag,vflag);
@@ -222,6 +224,24 @@ void Verlet::setup_minimal(int flag)
   update->setupflag = 0;
 }
 
+/* ----------------------------------------------------------------------
+   decide if forward comm can overlap with the pair computation
+   requires the pair style to support it and no pre_force fixes,
+     since those may access ghost atom coords
+------------------------------------------------------------------------- */
+
+void Verlet::overlap_setup()
+{
+  overlapflag = 0;
+  if (comm->overlap && pair_compute_flag && force->pair && force->pair->overlap_enable &&
+      (modify->n_pre_force == 0))
+    overlapflag = 1;
+
+  // neighbor list build count was reset, so force a new interior/boundary split
+
+  if (overlapflag) force->pair->overlap_reset();
+}
+
 /* ----------------------------------------------------------------------
    run for N steps
 ------------------------------------------------------------------------- */
@@ -265,7 +285,8 @@ void Verlet::run(int n)
 
     if (nflag == 0) {
       timer->stamp();
-      comm->forward_comm();
+      if (overlapflag) comm->forward_comm_begin();
+      else comm->forward_comm();
       timer->stamp(Timer::COMM);
     } else {
       if (n_pre_exchange) {
@@ -312,8 +333,17 @@ void Verlet::run(int n)
       timer->stamp(Timer::MODIFY);
     }
 
+    // with overlap, pair interactions between owned atoms are computed
+    // while the forward communication of ghost atom coords is in flight
+
     if (pair_compute_flag) {
-      force->pair->compute(eflag,vflag);
+      if (overlapflag && (nflag == 0)) {
+        force->pair->compute_interior(eflag,vflag);
+        timer->stamp(Timer::PAIR);
+        comm->forward_comm_end();
+        timer->stamp(Timer::COMM);
+        force->pair->compute_boundary(eflag,vflag);
+      } else force->pair->compute(eflag,vflag);
       timer->stamp(Timer::PAIR);
     }
 
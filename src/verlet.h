@@ -37,6 +37,9 @@ class Verlet : public Integrate {
  protected:
   int triclinic;    // 0 if domain is orthog, 1 if triclinic
   int torqueflag, extraflag;
+  int overlapflag;    // 1 if pair computation overlaps with forward comm
+
+  void overlap_setup();
 };
 
 }    // namespace LAMMPS_NS
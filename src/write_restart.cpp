@@ -42,6 +42,8 @@
 
 using namespace LAMMPS_NS;
 
+static constexpr double BIG = 1.0e20;
+
 /* ---------------------------------------------------------------------- */
 
 WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
@@ -51,6 +53,18 @@ WriteRestart::WriteRestart(LAMMPS *lmp) : Command(lmp)
   multiproc = 0;
   noinit = 0;
   fp = nullptr;
+  asyncflag = 0;
+  maxabuf = 0;
+  abuf = nullptr;
+  async_error = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+WriteRestart::~WriteRestart()
+{
+  async_wait(0);
+  memory->sfree(abuf);
 }
 
 /* ----------------------------------------------------------------------
@@ -84,6 +98,7 @@ void WriteRestart::command(int narg, char **arg)
   // also called by Output class for periodic restart files
 
   multiproc_options(multiproc,mpiioflag,narg-1,&arg[1]);
+  if (asyncflag) error->all(FLERR,"Write_restart async keyword is only supported by restart command");
 
   // init entire system since comm->exchange is done
   // comm::init needs neighbor::init needs pair::init needs kspace::init, etc
@@ -195,6 +210,12 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
     } else if (strcmp(arg[iarg],"noinit") == 0) {
       noinit = 1;
       iarg++;
+    } else if (strcmp(arg[iarg],"async") == 0) {
+      if (iarg+2 > narg) utils::missing_cmd_args(FLERR, "restart async", error);
+      asyncflag = utils::logical(FLERR,arg[iarg+1],false,lmp);
+      if (asyncflag && mpiioflag)
+        error->all(FLERR,"Restart file async output not allowed with MPI-IO");
+      iarg += 2;
     } else error->all(FLERR,"Unknown write_restart keyword: {}", arg[iarg]);
   }
 }
@@ -206,6 +227,10 @@ void WriteRestart::multiproc_options(int multiproc_caller, int mpiioflag_caller,
 
 void WriteRestart::write(const std::string &file)
 {
+  // wait for background writer to finish previous restart file
+
+  async_wait();
+
   // special case where reneighboring is not done in integrator
   //   on timestep restart file is written (due to build_once being set)
   // if box is changing, must be reset, else restart file will have
@@ -270,35 +295,6 @@ void WriteRestart::write(const std::string &file)
   memory->create(buf,max_size,"write_restart:buf");
   memset(buf,0,max_size*sizeof(double));
 
-  // all procs write file layout info which may include per-proc sizes
-
-  file_layout(send_size);
-
-  // header info is complete
-  // if multiproc output:
-  //   close header file, open multiname file on each writing proc,
-  //   write PROCSPERFILE into new file
-
-  int io_error = 0;
-  if (multiproc) {
-    if (me == 0 && fp) {
-      magic_string();
-      if (ferror(fp)) io_error = 1;
-      fclose(fp);
-      fp = nullptr;
-    }
-
-    std::string multiname = file;
-    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
-
-    if (filewriter) {
-      fp = fopen(multiname.c_str(),"wb");
-      if (fp == nullptr)
-        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
-      write_int(PROCSPERFILE,nclusterprocs);
-    }
-  }
-
   // pack my atom data into buf
 
   AtomVec *avec = atom->avec;
@@ -354,6 +350,61 @@ void WriteRestart::write(const std::string &file)
     }
   }
 
+  // bounding box of my atoms after remapping them into periodic box
+  // in lamda coords for triclinic, only used for single native file
+
+  double bbox[6];
+  bbox[0] = bbox[2] = bbox[4] = BIG;
+  bbox[1] = bbox[3] = bbox[5] = -BIG;
+
+  if (!multiproc && !mpiioflag) {
+    double xremap[3];
+    imageint imremap;
+    int m = 0;
+    for (int i = 0; i < atom->nlocal; i++) {
+      xremap[0] = buf[m+1];
+      xremap[1] = buf[m+2];
+      xremap[2] = buf[m+3];
+      imremap = 0;
+      domain->remap(xremap,imremap);
+      if (domain->triclinic) domain->x2lamda(xremap,xremap);
+      for (int idim = 0; idim < 3; idim++) {
+        bbox[2*idim] = MIN(bbox[2*idim],xremap[idim]);
+        bbox[2*idim+1] = MAX(bbox[2*idim+1],xremap[idim]);
+      }
+      m += static_cast<int> (buf[m]);
+    }
+  }
+
+  // all procs write file layout info which may include per-proc sizes
+
+  file_layout(send_size,bbox);
+
+  // header info is complete
+  // if multiproc output:
+  //   close header file, open multiname file on each writing proc,
+  //   write PROCSPERFILE into new file
+
+  int io_error = 0;
+  if (multiproc) {
+    if (me == 0 && fp) {
+      magic_string();
+      if (ferror(fp)) io_error = 1;
+      fclose(fp);
+      fp = nullptr;
+    }
+
+    std::string multiname = file;
+    multiname.replace(multiname.find('%'),1,fmt::format("{}",icluster));
+
+    if (filewriter) {
+      fp = fopen(multiname.c_str(),"wb");
+      if (fp == nullptr)
+        error->one(FLERR, "Cannot open restart file {}: {}", multiname, utils::getsyserror());
+      write_int(PROCSPERFILE,nclusterprocs);
+    }
+  }
+
   // MPI-IO output to single file
 
   if (mpiioflag) {
@@ -373,9 +424,36 @@ void WriteRestart::write(const std::string &file)
     // ping each proc in my cluster, receive its data, write data to file
     // else wait for ping from fileproc, send my data to fileproc
 
+    // async output: gather per-atom data of my cluster into abuf
+    // hand abuf to background thread for writing and closing the file
+
     int tmp,recv_size;
 
-    if (filewriter) {
+    if (filewriter && asyncflag) {
+      MPI_Status status;
+      MPI_Request request;
+      asizes.resize(nclusterprocs);
+      bigint offset = 0;
+      for (int iproc = 0; iproc < nclusterprocs; iproc++) {
+        if (offset + max_size > maxabuf) {
+          maxabuf = offset + max_size;
+          abuf = (double *) memory->srealloc(abuf,maxabuf*sizeof(double),"write_restart:abuf");
+        }
+        if (iproc) {
+          MPI_Irecv(&abuf[offset],max_size,MPI_DOUBLE,me+iproc,0,world,&request);
+          MPI_Send(&tmp,0,MPI_INT,me+iproc,0,world);
+          MPI_Wait(&request,&status);
+          MPI_Get_count(&status,MPI_DOUBLE,&recv_size);
+        } else {
+          recv_size = send_size;
+          if (send_size) memcpy(abuf,buf,sizeof(double)*send_size);
+        }
+        asizes[iproc] = recv_size;
+        offset += recv_size;
+      }
+      async_thread = std::thread(&WriteRestart::async_write,this);
+
+    } else if (filewriter) {
       MPI_Status status;
       MPI_Request request;
       for (int iproc = 0; iproc < nclusterprocs; iproc++) {
@@ -416,6 +494,43 @@ void WriteRestart::write(const std::string &file)
       fix->write_restart_file(file.c_str());
 }
 
+/* ----------------------------------------------------------------------
+   write per-atom data stored in abuf and close file, called in background thread
+   must not use MPI or error class, errors are flagged in async_error
+------------------------------------------------------------------------- */
+
+void WriteRestart::async_write()
+{
+  bigint offset = 0;
+  for (const auto &size : asizes) {
+    write_double_vec(PERPROC,size,&abuf[offset]);
+    offset += size;
+  }
+  magic_string();
+  if (ferror(fp)) async_error = 1;
+  if (fclose(fp) != 0) async_error = 1;
+  fp = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   wait for background writer to complete previous restart file
+   report any error it encountered
+   errflag = 0 when called from a destructor, which must not throw,
+     so the error is only printed as a warning
+------------------------------------------------------------------------- */
+
+void WriteRestart::async_wait(int errflag)
+{
+  if (!async_thread.joinable()) return;
+  async_thread.join();
+
+  if (async_error) {
+    async_error = 0;
+    if (errflag) error->one(FLERR,"I/O error while writing restart");
+    else error->warning(FLERR,"I/O error while writing restart");
+  }
+}
+
 /* ----------------------------------------------------------------------
    proc 0 writes out problem description
 ------------------------------------------------------------------------- */
@@ -576,13 +691,34 @@ void WriteRestart::force_fields()
    all procs call this method, only proc 0 writes to file
 ------------------------------------------------------------------------- */
 
-void WriteRestart::file_layout(int send_size)
+void WriteRestart::file_layout(int send_size, double *bbox)
 {
   if (me == 0) {
     write_int(MULTIPROC,multiproc);
     write_int(MPIIO,mpiioflag);
   }
 
+  // for single native file, write size and atom bounding box of each per-proc chunk
+  // allows procs to read the chunks with their atoms directly from file
+
+  if (!multiproc && !mpiioflag) {
+    int *all_send_sizes = nullptr;
+    double *all_bbox = nullptr;
+    if (me == 0) {
+      memory->create(all_send_sizes,nprocs,"write_restart:all_send_sizes");
+      memory->create(all_bbox,6*nprocs,"write_restart:all_bbox");
+    }
+    MPI_Gather(&send_size,1,MPI_INT,all_send_sizes,1,MPI_INT,0,world);
+    MPI_Gather(bbox,6,MPI_DOUBLE,all_bbox,6,MPI_DOUBLE,0,world);
+    if (me == 0) {
+      write_int(CHUNKMAP,nprocs);
+      fwrite(all_send_sizes,sizeof(int),nprocs,fp);
+      fwrite(all_bbox,sizeof(double),6*nprocs,fp);
+    }
+    memory->destroy(all_send_sizes);
+    memory->destroy(all_bbox);
+  }
+
   if (mpiioflag) {
     int *all_send_sizes;
     memory->create(all_send_sizes,nprocs,"write_restart:all_send_sizes");
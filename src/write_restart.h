@@ -22,14 +22,19 @@ CommandStyle(write_restart,WriteRestart);
 
 #include "command.h"
 
+#include <thread>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class WriteRestart : public Command {
  public:
   WriteRestart(class LAMMPS *);
+  ~WriteRestart() override;
   void command(int, char **) override;
   void multiproc_options(int, int, int, char **);
   void write(const std::string &);
+  void async_wait(int errflag = 1);
 
  private:
   int me, nprocs;
@@ -50,14 +55,24 @@ class WriteRestart : public Command {
   class RestartMPIIO *mpiio;    // MPIIO for restart file output
   MPI_Offset headerOffset;
 
+  // async output values
+
+  int asyncflag;                  // 1 if filewriter writes per-atom data in background thread
+  bigint maxabuf;                 // size of abuf
+  double *abuf;                   // per-atom data of my cluster for background thread
+  std::vector<int> asizes;        // size of each per-proc chunk in abuf
+  std::thread async_thread;       // background writer thread
+  int async_error;                // 1 if background writer had an I/O error
+
   void header();
   void type_arrays();
   void force_fields();
-  void file_layout(int);
+  void file_layout(int, double *);
 
   void magic_string();
   void endian();
   void version_numeric();
+  void async_write();
 
   void write_int(int, int);
   void write_bigint(int, bigint);
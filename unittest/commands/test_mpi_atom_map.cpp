@@ -0,0 +1,170 @@
+// unit tests for checking the hash table global -> local atom map in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIAtomMapTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+
+    void SetUp() override
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+
+        // small periodic box, so there are several images of each atom
+
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map hash");
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 2 0 2 0 2");
+        command("create_box      1 box");
+        command("create_atoms    1 box");
+        command("mass            1 1.0");
+        command("pair_style      lj/cut 2.5");
+        command("pair_coeff      1 1 1.0 1.0");
+        command("neighbor        0.3 bin");
+        command("neigh_modify    every 1 delay 0 check no");
+        command("run 0 post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // check map of all owned and ghost atoms of all procs
+    // map() must return the lowest index of each atom ID and the sametag
+    //   chain starting there must visit all other indices with that ID
+    // return total # of errors
+
+    int check_map()
+    {
+        Atom *atom = lmp->atom;
+        const int nall = atom->nlocal + atom->nghost;
+        std::map<tagint, std::vector<int>> images;
+        for (int i = 0; i < nall; ++i) images[atom->tag[i]].push_back(i);
+
+        int nbad = 0;
+        for (auto &one : images) {
+            int j = atom->map(one.first);
+            for (auto i : one.second) {
+                if (j != i) ++nbad;
+                if (j >= 0) j = atom->sametag[j];
+            }
+            if (j != -1) ++nbad;
+        }
+
+        int allbad = 0;
+        MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        return allbad;
+    }
+
+    // check that each atom ID is owned by exactly one proc
+
+    bigint count_owned()
+    {
+        Atom *atom = lmp->atom;
+        bigint nfound = 0;
+        for (tagint id = 1; id <= atom->map_tag_max; ++id) {
+            int i = atom->map(id);
+            if (i >= 0 && i < atom->nlocal && atom->tag[i] == id) ++nfound;
+        }
+        bigint nall = 0;
+        MPI_Allreduce(&nfound, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+        return nall;
+    }
+};
+
+TEST_F(MPIAtomMapTest, periodic_images)
+{
+    ASSERT_EQ(lmp->atom->map_style, Atom::MAP_HASH);
+    ASSERT_EQ(lmp->atom->natoms, 32);
+
+    // every atom must have several images on each proc
+
+    int nimages = (lmp->atom->nlocal + lmp->atom->nghost > 2 * 32) ? 0 : 1;
+    int allimages = 0;
+    MPI_Allreduce(&nimages, &allimages, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(allimages, 0);
+
+    EXPECT_EQ(check_map(), 0);
+    EXPECT_EQ(count_owned(), 32);
+}
+
+TEST_F(MPIAtomMapTest, map_one_grow)
+{
+    Atom *atom = lmp->atom;
+    const tagint idmax = atom->map_tag_max;
+    const int nextra = 20000;
+
+    // use map as scratch space for many other IDs, like Special does,
+    //   which requires the table to grow
+
+    atom->map_clear();
+    int nbad = 0;
+    for (tagint id = 1; id <= idmax; ++id)
+        if (atom->map(id) != -1) ++nbad;
+
+    for (int k = 0; k < nextra; ++k) atom->map_one(idmax + 1 + 7 * k, k);
+    for (int k = 0; k < nextra; ++k)
+        if (atom->map(idmax + 1 + 7 * k) != k) ++nbad;
+    for (int k = 0; k < nextra; ++k)
+        if (atom->map(idmax + 2 + 7 * k) != -1) ++nbad;
+    for (int k = 0; k < nextra; k += 2) atom->map_one(idmax + 1 + 7 * k, -1);
+    for (int k = 0; k < nextra; ++k)
+        if (atom->map(idmax + 1 + 7 * k) != ((k % 2) ? k : -1)) ++nbad;
+
+    int allbad = 0;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+
+    // re-create map
+
+    atom->map_init(0);
+    atom->map_set();
+    EXPECT_EQ(check_map(), 0);
+    EXPECT_EQ(count_owned(), 32);
+    nbad = (atom->map(idmax + 8) == -1) ? 0 : 1;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+}
+
+TEST_F(MPIAtomMapTest, migrate)
+{
+    // hot system that is reneighbored every step, so the map is
+    //   cleared and set again after atoms migrate between procs
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("velocity all create 5.0 87287 loop geom");
+    command("fix 1 all nve");
+    command("run 200 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ(check_map(), 0);
+    EXPECT_EQ(count_owned(), 32);
+}
+
+} // namespace LAMMPS_NS
@@ -0,0 +1,340 @@
+// unit tests for checking that the optional LAMMPS MPI communication modes
+// give the same results as the default communication
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "fix.h"
+#include "info.h"
+#include "input.h"
+#include "lammps.h"
+#include "memory.h"
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+// minimal fix with nvalues per-atom values for testing forward and
+// reverse communication. it is not added to Modify.
+
+class FixCommTest : public Fix {
+public:
+    FixCommTest(LAMMPS *lmp, char **arg, int n) : Fix(lmp, 3, arg), nvalues(n)
+    {
+        comm_forward = comm_reverse = nvalues;
+        memory->create(data, atom->nmax, nvalues, "comm_test:data");
+    }
+    ~FixCommTest() override { memory->destroy(data); }
+    int setmask() override { return 0; }
+
+    int pack_forward_comm(int n, int *list, double *buf, int, int *) override
+    {
+        int m = 0;
+        for (int i = 0; i < n; ++i)
+            for (int k = 0; k < nvalues; ++k) buf[m++] = data[list[i]][k];
+        return m;
+    }
+
+    void unpack_forward_comm(int n, int first, double *buf) override
+    {
+        int m = 0;
+        for (int i = first; i < first + n; ++i)
+            for (int k = 0; k < nvalues; ++k) data[i][k] = buf[m++];
+    }
+
+    int pack_reverse_comm(int n, int first, double *buf) override
+    {
+        int m = 0;
+        for (int i = first; i < first + n; ++i)
+            for (int k = 0; k < nvalues; ++k) buf[m++] = data[i][k];
+        return m;
+    }
+
+    void unpack_reverse_comm(int n, int *list, double *buf) override
+    {
+        int m = 0;
+        for (int i = 0; i < n; ++i)
+            for (int k = 0; k < nvalues; ++k) data[list[i]][k] += buf[m++];
+    }
+
+    // owned atoms get values derived from their atom ID, ghost atoms
+    // get the given value or the same as owned atoms for reverse comm
+
+    void reset(double ghost, bool reverse = false)
+    {
+        for (int i = 0; i < atom->nlocal + atom->nghost; ++i)
+            for (int k = 0; k < nvalues; ++k) {
+                if (i < atom->nlocal || reverse)
+                    data[i][k] = (k + 1.0) * atom->tag[i];
+                else
+                    data[i][k] = ghost;
+            }
+    }
+
+    std::vector<double> values() const
+    {
+        std::vector<double> all;
+        for (int i = 0; i < atom->nlocal + atom->nghost; ++i)
+            for (int k = 0; k < nvalues; ++k) all.push_back(data[i][k]);
+        return all;
+    }
+
+    int nvalues;
+    double **data = nullptr;
+};
+
+class MPICommModesTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+    int nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        create();
+    }
+
+    void TearDown() override { destroy(); }
+
+    void create()
+    {
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void destroy()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // set up a fcc crystal with 2048 atoms and a pair style.
+    // neighbor lists are rebuilt every 10 steps, so that there are
+    // forward and reverse communications without reneighboring.
+
+    void init_system(const std::string &pair)
+    {
+        if (pair == "eam") {
+            command("units           metal");
+            command("atom_style      atomic");
+            command("atom_modify     map array");
+            command("lattice         fcc 3.615");
+            command("region          box block 0 8 0 8 0 8");
+            command("create_box      1 box");
+            command("create_atoms    1 box");
+            command("pair_style      eam");
+            command("pair_coeff      1 1 Cu_u3.eam");
+            command("velocity        all create 600.0 87287 loop geom");
+        } else {
+            command("units           lj");
+            command("atom_style      atomic");
+            command("atom_modify     map array");
+            command("lattice         fcc 0.8442");
+            command("region          box block 0 8 0 8 0 8");
+            command("create_box      1 box");
+            command("create_atoms    1 box");
+            command("mass            1 1.0");
+            command("pair_style      lj/cut 2.5");
+            command("pair_coeff      1 1 1.0 1.0");
+            command("velocity        all create 1.44 87287 loop geom");
+        }
+        command("neighbor        0.3 bin");
+        command("neigh_modify    every 10 delay 0 check no");
+        command("fix             1 all nve");
+    }
+
+    // run with the given comm_modify settings and return per-atom
+    // coordinates and forces ordered by atom ID and the coordinates
+    // of the ghost atoms of this proc as they were last communicated
+
+    void run_system(const std::string &pair, const std::string &modify, int nsteps,
+                    std::vector<double> &x, std::vector<double> &f, std::vector<double> &xghost)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        init_system(pair);
+        if (!modify.empty()) command("comm_modify " + modify);
+        command("run " + std::to_string(nsteps) + " post no");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        x = gather(lmp->atom->x);
+        f = gather(lmp->atom->f);
+
+        Atom *atom = lmp->atom;
+        xghost.clear();
+        for (int i = atom->nlocal; i < atom->nlocal + atom->nghost; ++i)
+            for (int k = 0; k < 3; ++k) xghost.push_back(atom->x[i][k]);
+    }
+
+    // per-atom vector of owned atoms ordered by atom ID on all procs
+
+    std::vector<double> gather(double **array)
+    {
+        Atom *atom = lmp->atom;
+        const int natoms = (int) atom->natoms;
+        std::vector<double> mine(3 * natoms, 0.0), all(3 * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k) mine[3 * (atom->tag[i] - 1) + k] = array[i][k];
+        MPI_Allreduce(mine.data(), all.data(), 3 * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        return all;
+    }
+
+    // compare two per-atom vectors, allowing for round-off from summation order
+
+    static int compare(const std::vector<double> &ref, const std::vector<double> &val,
+                       double epsilon)
+    {
+        if (ref.size() != val.size()) return 1;
+        int nbad = 0;
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            if (fabs(ref[i] - val[i]) > epsilon * (1.0 + fabs(ref[i]))) ++nbad;
+        return nbad;
+    }
+
+    // compare results with and without the given comm_modify settings.
+    // optionally also compare the ghost atoms of each proc, which must be
+    // the same atoms in the same order.
+
+    void check_mode(const std::string &pair, const std::string &modify, double epsilon,
+                    bool ghostflag = false)
+    {
+        std::vector<double> xref, fref, gref, x, f, g;
+        if (lmp->domain->box_exist) {
+            destroy();
+            create();
+        }
+        run_system(pair, "", 25, xref, fref, gref);
+        destroy();
+        create();
+        run_system(pair, modify, 25, x, f, g);
+        EXPECT_EQ(compare(xref, x, epsilon), 0);
+        EXPECT_EQ(compare(fref, f, epsilon), 0);
+        if (ghostflag) {
+            int nbad = compare(gref, g, epsilon);
+            int allbad = 0;
+            MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+            EXPECT_EQ(allbad, 0);
+        }
+    }
+};
+
+TEST_F(MPICommModesTest, overlap_lj)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    check_mode("lj", "overlap yes", 1.0e-10);
+}
+
+TEST_F(MPICommModesTest, overlap_eam)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    if (!Info(lmp).has_style("pair", "eam")) GTEST_SKIP();
+    check_mode("eam", "overlap yes", 1.0e-10);
+}
+
+TEST_F(MPICommModesTest, direct)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    check_mode("lj", "direct yes", 1.0e-10, true);
+}
+
+TEST_F(MPICommModesTest, direct_overlap)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    check_mode("lj", "direct yes overlap yes", 1.0e-10, true);
+}
+
+TEST_F(MPICommModesTest, shared)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    check_mode("lj", "shared yes", 1.0e-10, true);
+    if (Info(lmp).has_style("pair", "eam")) check_mode("eam", "shared yes", 1.0e-10, true);
+}
+
+TEST_F(MPICommModesTest, precision_single)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    check_mode("lj", "precision single", 1.0e-6, true);
+    if (Info(lmp).has_style("pair", "eam")) check_mode("eam", "precision single", 1.0e-6, true);
+}
+
+TEST_F(MPICommModesTest, batch)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    if (!verbose) ::testing::internal::CaptureStdout();
+    init_system("lj");
+    command("run 0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    char *arga[] = {(char *) "a", (char *) "all", (char *) "comm/test"};
+    char *argb[] = {(char *) "b", (char *) "all", (char *) "comm/test"};
+    FixCommTest fixa(lmp, arga, 1), fixb(lmp, argb, 3);
+    Comm *comm = lmp->comm;
+    Atom *atom = lmp->atom;
+
+    // forward comm with separate calls and as batch
+    // ghost atoms must have the values of the owned atom with the same ID
+
+    fixa.reset(-1.0);
+    fixb.reset(-1.0);
+    comm->forward_comm(&fixa);
+    comm->forward_comm(&fixb);
+    auto refa = fixa.values();
+    auto refb = fixb.values();
+
+    int nbad = 0;
+    for (int i = atom->nlocal; i < atom->nlocal + atom->nghost; ++i) {
+        if (fixa.data[i][0] != atom->tag[i]) ++nbad;
+        if (fixb.data[i][2] != 3.0 * atom->tag[i]) ++nbad;
+    }
+
+    fixa.reset(-1.0);
+    fixb.reset(-1.0);
+    comm->add_batch(&fixa);
+    comm->add_batch(&fixb);
+    comm->forward_comm_batch();
+    nbad += compare(refa, fixa.values(), 0.0);
+    nbad += compare(refb, fixb.values(), 0.0);
+
+    // a batch with a single client
+
+    fixb.reset(-1.0);
+    comm->add_batch(&fixb);
+    comm->forward_comm_batch();
+    nbad += compare(refb, fixb.values(), 0.0);
+
+    // reverse comm with separate calls and as batch
+
+    fixa.reset(0.0, true);
+    fixb.reset(0.0, true);
+    comm->reverse_comm(&fixa);
+    comm->reverse_comm(&fixb);
+    refa = fixa.values();
+    refb = fixb.values();
+
+    fixa.reset(0.0, true);
+    fixb.reset(0.0, true);
+    comm->add_batch(&fixa);
+    comm->add_batch(&fixb);
+    comm->reverse_comm_batch();
+    nbad += compare(refa, fixa.values(), 0.0);
+    nbad += compare(refb, fixb.values(), 0.0);
+
+    int allbad = 0;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+}
+
+} // namespace LAMMPS_NS
@@ -4,12 +4,18 @@
 #include "atom.h"
 #include "comm.h"
 #include "domain.h"
+#include "group.h"
+#include "imbalance_model.h"
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
 #include "neighbor.h"
 #include "timer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -189,6 +195,150 @@ TEST_F(MPILoadBalanceTest, rcb)
     ASSERT_GT(dz, lmp->neighbor->skin);
 }
 
+TEST_F(MPILoadBalanceTest, rcb_relax)
+{
+    command("comm_style tiled");
+    command("create_atoms 1 random 400 4732 NULL");
+    ASSERT_EQ(lmp->atom->natoms, 400);
+
+    // without a previous rcb balancing this does a full rcb balancing
+    command("balance 1 rcb/relax 0.1");
+
+    bigint nlocal = lmp->atom->nlocal;
+    bigint nall;
+    MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(nall, 400);
+    EXPECT_NEAR(lmp->atom->nlocal, 100, 1);
+
+    // add atoms on one side of the box to create an imbalance
+
+    command("region left block 0 5 0 20 0 20");
+    command("create_atoms 1 random 200 7439 left");
+    ASSERT_EQ(lmp->atom->natoms, 600);
+
+    int maxold, maxnew;
+    int mylocal = lmp->atom->nlocal;
+    MPI_Allreduce(&mylocal, &maxold, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    double oldsplit[3][2];
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 2; ++j) oldsplit[i][j] = lmp->comm->mysplit[i][j];
+
+    command("balance 1 rcb/relax 0.1");
+
+    // no atoms are lost, each cut moved by at most 10% of the box and
+    // the imbalance is reduced
+
+    nlocal = lmp->atom->nlocal;
+    MPI_Allreduce(&nlocal, &nall, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+    ASSERT_EQ(nall, 600);
+
+    double maxshift = 0.0;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 2; ++j)
+            maxshift = std::max(maxshift, fabs(lmp->comm->mysplit[i][j] - oldsplit[i][j]));
+    double allshift;
+    MPI_Allreduce(&maxshift, &allshift, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    ASSERT_GT(allshift, 0.0);
+    ASSERT_LE(allshift, 0.1 + 1.0e-10);
+
+    mylocal = lmp->atom->nlocal;
+    MPI_Allreduce(&mylocal, &maxnew, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    ASSERT_LT(maxnew, maxold);
+
+    // atoms must be inside their new sub-domain
+
+    int nbad = 0;
+    for (int i = 0; i < lmp->atom->nlocal; ++i)
+        for (int k = 0; k < 3; ++k)
+            if (lmp->atom->x[i][k] < lmp->domain->sublo[k] ||
+                lmp->atom->x[i][k] >= lmp->domain->subhi[k])
+                ++nbad;
+    EXPECT_EQ(nbad, 0);
+}
+
+TEST_F(MPILoadBalanceTest, weight_model)
+{
+    command("create_atoms 1 random 400 4732 NULL");
+    command("region left block 0 10 0 20 0 20");
+    command("group left region left");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("run 0 post no");
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+
+    // fixed timings: atoms in group left are 4x as expensive
+
+    const int nlocal = lmp->atom->nlocal;
+    const int leftbit = lmp->group->bitmask[lmp->group->find("left")];
+    double cost = 0.0;
+    for (int i = 0; i < nlocal; ++i)
+        cost += (lmp->atom->mask[i] & leftbit) ? 0.004 : 0.001;
+
+    auto fit_weights = [&]() {
+        for (int i = Timer::TOTAL; i < Timer::NUM_TIMER; ++i)
+            lmp->timer->set_wall((Timer::ttype) i, 0.0);
+        lmp->timer->set_wall(Timer::PAIR, cost);
+
+        ImbalanceModel model(lmp);
+        char *args[] = {(char *) "0.5", (char *) "group", (char *) "left"};
+        model.options(3, args);
+        model.init(0);
+        std::vector<double> weight(nlocal, 1.0);
+        model.compute(weight.data());
+        return weight;
+    };
+
+    // the same timings must give the same weights
+
+    auto weight = fit_weights();
+    auto again = fit_weights();
+    int nbad = (weight == again) ? 0 : 1;
+    int allbad = 0;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+
+    // the weights of each proc must add up to its cost
+
+    double wsum = 0.0;
+    for (int i = 0; i < nlocal; ++i) wsum += weight[i];
+    EXPECT_NEAR(wsum, cost, 0.02 * cost);
+}
+
+TEST_F(MPILoadBalanceTest, rcb_rendezvous_node)
+{
+#if !defined(MPI_VERSION) || (MPI_VERSION < 3)
+    GTEST_SKIP();
+#endif
+    // owned atoms of each proc after rcb balancing as sorted (ID, x, y, z)
+
+    auto balance = [&](const std::string &mode) {
+        command("comm_style tiled");
+        command("comm_modify rendezvous " + mode);
+        command("create_atoms 1 random 400 4732 NULL");
+        command("region left block 0 5 0 20 0 20");
+        command("create_atoms 1 random 200 7439 left");
+        command("balance 1 rcb");
+        command("balance 1 rcb/relax 0.2");
+
+        std::vector<std::array<double, 4>> atoms;
+        for (int i = 0; i < lmp->atom->nlocal; ++i)
+            atoms.push_back({(double) lmp->atom->tag[i], lmp->atom->x[i][0], lmp->atom->x[i][1],
+                             lmp->atom->x[i][2]});
+        std::sort(atoms.begin(), atoms.end());
+        return atoms;
+    };
+
+    auto flat = balance("flat");
+    TearDown();
+    SetUp();
+    auto node = balance("node");
+
+    int nbad = (flat == node) ? 0 : 1;
+    int allbad = 0;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+}
+
 TEST_F(MPILoadBalanceTest, rcb_min_size)
 {
     GTEST_SKIP();
@@ -0,0 +1,159 @@
+// unit tests for checking the construction of special neighbor lists in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "input.h"
+#include "lammps.h"
+#include "special.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPISpecialTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+    int nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // 16 rings of 8 bonded atoms each along x
+
+    void init_system(const std::string &weights)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("units           metal");
+        command("atom_style      bond");
+        command("atom_modify     map array");
+        command("lattice         custom 1.0 a1 1.0 0.0 0.0 a2 0.0 2.0 0.0 a3 0.0 0.0 2.0 "
+                "basis 0.0 0.0 0.0");
+        command("region          box block 0 8 0 4 0 4");
+        command("create_box      1 box bond/types 1 extra/bond/per/atom 4 "
+                "extra/special/per/atom 40");
+        command("create_atoms    1 box");
+        command("mass            1 1.0");
+        command("pair_style      zero 2.0");
+        command("pair_coeff      * *");
+        command("bond_style      zero");
+        command("bond_coeff      *");
+        command("special_bonds   " + weights);
+        command("create_bonds    many all all 1 0.9 1.1");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // special lists of owned atoms with each of the 1-2, 1-3, 1-4 parts sorted
+
+    std::vector<std::vector<tagint>> special_lists()
+    {
+        Atom *atom = lmp->atom;
+        std::vector<std::vector<tagint>> lists;
+        for (int i = 0; i < atom->nlocal; ++i) {
+            std::vector<tagint> one(atom->special[i], atom->special[i] + atom->nspecial[i][2]);
+            std::sort(one.begin(), one.begin() + atom->nspecial[i][0]);
+            std::sort(one.begin() + atom->nspecial[i][0], one.begin() + atom->nspecial[i][1]);
+            std::sort(one.begin() + atom->nspecial[i][1], one.end());
+            one.push_back(atom->nspecial[i][0]);
+            one.push_back(atom->nspecial[i][1]);
+            lists.push_back(one);
+        }
+        return lists;
+    }
+
+    // add bonds between rings and compare the incrementally updated special
+    // lists with those from a full rebuild
+
+    void check_update()
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("create_bonds single/bond 1 1 100");
+        command("create_bonds single/bond 1 2 70");
+        command("create_bonds single/bond 1 100 128");
+        command("create_bonds single/bond 1 5 64");
+        command("create_bonds single/bond 1 64 33");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        auto updated = special_lists();
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        Special special(lmp);
+        special.build();
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        auto rebuilt = special_lists();
+
+        int nbad = (updated == rebuilt) ? 0 : 1;
+        int allbad = 0;
+        MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+        EXPECT_EQ(allbad, 0);
+        EXPECT_EQ(lmp->atom->nbonds, 133);
+    }
+};
+
+TEST_F(MPISpecialTest, create_bonds_update)
+{
+    init_system("lj/coul 0.0 0.5 0.7");
+    check_update();
+}
+
+TEST_F(MPISpecialTest, create_bonds_update_onetwo)
+{
+    init_system("lj/coul 0.0 1.0 1.0");
+    check_update();
+}
+
+TEST_F(MPISpecialTest, create_bonds_update_onethree)
+{
+    init_system("lj/coul 0.0 0.0 1.0");
+    check_update();
+}
+
+TEST_F(MPISpecialTest, rendezvous_node)
+{
+#if !defined(MPI_VERSION) || (MPI_VERSION < 3)
+    GTEST_SKIP();
+#endif
+    init_system("lj/coul 0.0 0.5 0.7");
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("create_bonds single/bond 1 1 100");
+    command("create_bonds single/bond 1 2 70");
+    command("comm_modify rendezvous flat");
+    Special(lmp).build();
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    auto flat = special_lists();
+
+    if (!verbose) ::testing::internal::CaptureStdout();
+    command("comm_modify rendezvous node");
+    Special(lmp).build();
+    if (!verbose) ::testing::internal::GetCapturedStdout();
+    auto node = special_lists();
+
+    int nbad = (flat == node) ? 0 : 1;
+    int allbad = 0;
+    MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    EXPECT_EQ(allbad, 0);
+}
+
+} // namespace LAMMPS_NS
@@ -16,6 +16,7 @@
 #include "../testing/utils.h"
 #include "fmt/format.h"
 #include "output.h"
+#include "platform.h"
 #include "thermo.h"
 #include "utils.h"
 #include "gmock/gmock.h"
@@ -324,6 +325,51 @@ TEST_F(DumpCustomTest, run2)
     delete_file(dump_file);
 }
 
+TEST_F(DumpCustomTest, async_run2)
+{
+    auto dump_file = dump_filename("async_run2");
+    auto fields    = "id type x y z";
+    generate_dump(dump_file, fields, "async yes", 2);
+    close_dump();
+
+    ASSERT_FILE_EXISTS(dump_file);
+    ASSERT_EQ(count_lines(dump_file), 123);
+    delete_file(dump_file);
+}
+
+TEST_F(DumpCustomTest, async_nobuffer_multi_file_run1)
+{
+    auto base_name   = "multi_file_async_run1_*.melt";
+    auto base_name_0 = "multi_file_async_run1_0.melt";
+    auto base_name_1 = "multi_file_async_run1_1.melt";
+    auto fields      = "id type x y z";
+    generate_dump(base_name, fields, "async yes buffer no", 1);
+    close_dump();
+
+    ASSERT_FILE_EXISTS(base_name_0);
+    ASSERT_FILE_EXISTS(base_name_1);
+    auto lines = read_lines(base_name_1);
+    ASSERT_EQ(lines.size(), 41);
+    ASSERT_THAT(lines[1], Eq("1"));
+    ASSERT_THAT(lines[8], Eq(fmt::format("ITEM: ATOMS {}", fields)));
+    ASSERT_EQ(utils::split_words(lines[40]).size(), 5);
+    delete_file(base_name_0);
+    delete_file(base_name_1);
+}
+
+TEST_F(DumpCustomTest, async_write_error)
+{
+    if (!platform::file_is_readable("/dev/full")) GTEST_SKIP();
+
+    // writes to /dev/full fail when the background writer flushes the file
+
+    BEGIN_HIDE_OUTPUT();
+    command("dump id all custom 1 /dev/full id type x y z");
+    command("dump_modify id async yes");
+    END_HIDE_OUTPUT();
+    TEST_FAILURE(".*ERROR on proc 0: Error writing dump id.*", command("run 1 post no"););
+}
+
 TEST_F(DumpCustomTest, rerun)
 {
     auto dump_file = dump_filename("rerun");
@@ -19,6 +19,7 @@
 #include "info.h"
 #include "input.h"
 #include "lammps.h"
+#include "platform.h"
 #include "update.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -391,7 +392,35 @@ TEST_F(FileOperationsTest, write_restart)
     ASSERT_EQ(lmp->update->ntimestep, 333);
     ASSERT_EQ(lmp->domain->triclinic, 1);
 
+    BEGIN_HIDE_OUTPUT();
+    command("restart 1 async.restart async yes");
+    command("run 2 post no");
+    command("restart 0");
+    END_HIDE_OUTPUT();
+    ASSERT_FILE_EXISTS("async.restart.334");
+    ASSERT_FILE_EXISTS("async.restart.335");
+    if (platform::file_is_readable("/dev/full")) {
+        BEGIN_HIDE_OUTPUT();
+        command("restart 1 /dev/full /dev/full async yes");
+        END_HIDE_OUTPUT();
+        TEST_FAILURE(".*ERROR on proc 0: I/O error while writing restart.*",
+                     command("run 1 post no"););
+        BEGIN_HIDE_OUTPUT();
+        command("restart 0");
+        END_HIDE_OUTPUT();
+    }
+    TEST_FAILURE(".*ERROR: Write_restart async keyword is only supported by restart command.*",
+                 command("write_restart test.restart async yes"););
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("read_restart async.restart.335");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->update->ntimestep, 335);
+
     // clean up
+    delete_file("async.restart.334");
+    delete_file("async.restart.335");
     delete_file("noinit.restart");
     delete_file("test.restart");
     delete_file("step333.restart");
@@ -493,6 +522,17 @@ TEST_F(FileOperationsTest, write_data)
     END_HIDE_OUTPUT();
     ASSERT_EQ(lmp->atom->natoms, 1);
     ASSERT_EQ(lmp->domain->triclinic, 1);
+    BEGIN_HIDE_OUTPUT();
+    command("clear");
+    command("pair_style zero 1.0");
+    command("read_data triclinic.data parallel yes");
+    END_HIDE_OUTPUT();
+    ASSERT_EQ(lmp->atom->natoms, 1);
+    ASSERT_EQ(lmp->atom->nlocal, 1);
+    ASSERT_EQ(lmp->domain->triclinic, 1);
+    ASSERT_DOUBLE_EQ(lmp->atom->x[0][0], 0.5);
+    TEST_FAILURE(".*ERROR: Read_data parallel yes cannot be used with add keyword.*",
+                 command("read_data triclinic.data add append parallel yes"););
 
     // clean up
     delete_file("charge.data");
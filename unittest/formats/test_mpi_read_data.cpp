@@ -0,0 +1,183 @@
+// unit tests for reading the Atoms section of data files in parallel
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIReadDataTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, MPI_COMM_WORLD);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void TearDown() override
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        delete lmp;
+        lmp = nullptr;
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (me == 0) remove("parallel.data");
+    }
+
+    // write data file of a randomly displaced fcc lattice with velocities
+
+    void write_system(bool triclinic)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map array");
+        command("lattice         fcc 0.8442");
+        if (triclinic) {
+            command("region          box prism 0 6 0 6 0 6 1.0 -0.5 0.5");
+        } else {
+            command("region          box block 0 6 0 6 0 6");
+        }
+        command("create_box      2 box");
+        command("create_atoms    1 box");
+        command("set             type 1 type/fraction 2 0.3 48937");
+        command("mass            * 1.0");
+        command("displace_atoms  all random 0.3 0.3 0.3 87287");
+        command("velocity        all create 1.0 4928459 loop geom");
+        command("write_data      parallel.data");
+        command("clear");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    // per-atom type, image, coordinates and velocities ordered by atom ID
+
+    std::vector<double> gather()
+    {
+        Atom *atom = lmp->atom;
+        const int natoms = (int) atom->natoms;
+        const int nvalues = 8;
+        std::vector<double> mine(nvalues * natoms, 0.0), all(nvalues * natoms, 0.0);
+        for (int i = 0; i < atom->nlocal; ++i) {
+            double *one = &mine[nvalues * (atom->tag[i] - 1)];
+            one[0] = atom->type[i];
+            one[1] = atom->image[i];
+            for (int k = 0; k < 3; ++k) {
+                one[2 + k] = atom->x[i][k];
+                one[5 + k] = atom->v[i][k];
+            }
+        }
+        MPI_Allreduce(mine.data(), all.data(), nvalues * natoms, MPI_DOUBLE, MPI_SUM, lmp->world);
+        return all;
+    }
+
+    // number of owned atoms outside of my sub-domain on any proc
+
+    int misplaced()
+    {
+        Atom *atom = lmp->atom;
+        Domain *domain = lmp->domain;
+        if (domain->triclinic) domain->x2lamda(atom->nlocal);
+        double *lo = domain->triclinic ? domain->sublo_lamda : domain->sublo;
+        double *hi = domain->triclinic ? domain->subhi_lamda : domain->subhi;
+        int nbad = 0;
+        for (int i = 0; i < atom->nlocal; ++i)
+            for (int k = 0; k < 3; ++k)
+                if (atom->x[i][k] < lo[k] || atom->x[i][k] >= hi[k]) ++nbad;
+        if (domain->triclinic) domain->lamda2x(atom->nlocal);
+        int allbad = 0;
+        MPI_Allreduce(&nbad, &allbad, 1, MPI_INT, MPI_SUM, lmp->world);
+        return allbad;
+    }
+
+    // compare per-atom data, allowing for round-off from the conversion
+    //   to and from fractional coordinates for triclinic boxes
+
+    static int compare(const std::vector<double> &ref, const std::vector<double> &val)
+    {
+        if (ref.size() != val.size()) return 1;
+        int nbad = 0;
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            if (fabs(ref[i] - val[i]) > 1.0e-13 * (1.0 + fabs(ref[i]))) ++nbad;
+        return nbad;
+    }
+
+    // read data file in the default way and in parallel and compare
+
+    void check_read(const std::string &setup, bigint natoms)
+    {
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        if (!setup.empty()) command(setup);
+        command("read_data parallel.data");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        ASSERT_EQ(lmp->atom->natoms, natoms);
+        auto ref = gather();
+
+        if (!verbose) ::testing::internal::CaptureStdout();
+        command("clear");
+        if (!setup.empty()) command(setup);
+        command("read_data parallel.data parallel yes");
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+        ASSERT_EQ(lmp->atom->natoms, natoms);
+        EXPECT_EQ(compare(ref, gather()), 0);
+        EXPECT_EQ(misplaced(), 0);
+    }
+};
+
+TEST_F(MPIReadDataTest, orthogonal)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    write_system(false);
+    check_read("", 864);
+}
+
+TEST_F(MPIReadDataTest, triclinic)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    write_system(true);
+    check_read("", 864);
+}
+
+TEST_F(MPIReadDataTest, atoms_last)
+{
+    if (nprocs < 4) GTEST_SKIP();
+
+    // few atoms in a data file ending with the Atoms section and no
+    //   trailing blank line, so some procs have no lines of the section
+
+    if (me == 0) {
+        FILE *fp = fopen("parallel.data", "w");
+        fputs("# Atoms section at end of file\n\n6 atoms\n1 atom types\n\n"
+              "0 4 xlo xhi\n0 4 ylo yhi\n0 4 zlo zhi\n\nMasses\n\n1 1.0\n\nAtoms # atomic\n\n",
+              fp);
+        for (int i = 1; i <= 6; ++i)
+            fprintf(fp, "%d 1 %g %g %g 0 0 0\n", 7 - i, 0.6 * i, 0.5 * i, 3.9 - 0.6 * i);
+        fclose(fp);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    check_read("atom_modify map array", 6);
+}
+
+} // namespace LAMMPS_NS
@@ -0,0 +1,159 @@
+// unit tests for reading restart files with a different number of MPI ranks
+
+#define LAMMPS_LIB_MPI 1
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "input.h"
+#include "lammps.h"
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "../testing/test_mpi_main.h"
+
+namespace LAMMPS_NS {
+
+class MPIRestartTest : public ::testing::Test {
+public:
+    void command(const std::string &line) { lmp->input->one(line); }
+
+protected:
+    const char *testbinary = "LAMMPSTest";
+    LAMMPS *lmp = nullptr;
+    int me, nprocs;
+
+    void SetUp() override
+    {
+        MPI_Comm_rank(MPI_COMM_WORLD, &me);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+    }
+
+    void TearDown() override
+    {
+        if (me == 0) remove("chunk.restart");
+    }
+
+    // create LAMMPS instance on the first n ranks, nullptr on the others
+
+    void create(int n)
+    {
+        MPI_Comm comm;
+        MPI_Comm_split(MPI_COMM_WORLD, (me < n) ? 0 : MPI_UNDEFINED, me, &comm);
+        if (comm == MPI_COMM_NULL) return;
+        LAMMPS::argv args = {testbinary, "-log", "none", "-echo", "screen", "-nocite"};
+        if (!verbose) ::testing::internal::CaptureStdout();
+        lmp = new LAMMPS(args, comm);
+        if (!verbose) ::testing::internal::GetCapturedStdout();
+    }
+
+    void destroy()
+    {
+        if (lmp) {
+            MPI_Comm comm = lmp->world;
+            if (!verbose) ::testing::internal::CaptureStdout();
+            delete lmp;
+            lmp = nullptr;
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            if (comm != MPI_COMM_WORLD) MPI_Comm_free(&comm);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    void init_system()
+    {
+        command("units           lj");
+        command("atom_style      atomic");
+        command("atom_modify     map array");
+        command("lattice         fcc 0.8442");
+        command("region          box block 0 6 0 6 0 6");
+        command("create_box      1 box");
+        command("create_atoms    1 box");
+        command("mass            1 1.0");
+        command("displace_atoms  all random 0.2 0.2 0.2 87287");
+    }
+
+    // checksums of atom IDs and positions and # of misplaced atoms
+
+    void checksum(bigint &tagsum, double &xsum, int &nbad)
+    {
+        Atom *atom = lmp->atom;
+        Domain *domain = lmp->domain;
+        bigint mytag = 0;
+        double myx = 0.0;
+        int mybad = 0;
+        for (int i = 0; i < atom->nlocal; ++i) {
+            double *x = atom->x[i];
+            mytag += atom->tag[i];
+            myx += atom->tag[i] * (x[0] + 2.0 * x[1] + 3.0 * x[2]);
+            for (int k = 0; k < 3; ++k)
+                if (x[k] < domain->sublo[k] || x[k] >= domain->subhi[k]) ++mybad;
+        }
+        MPI_Allreduce(&mytag, &tagsum, 1, MPI_LMP_BIGINT, MPI_SUM, lmp->world);
+        MPI_Allreduce(&myx, &xsum, 1, MPI_DOUBLE, MPI_SUM, lmp->world);
+        MPI_Allreduce(&mybad, &nbad, 1, MPI_INT, MPI_SUM, lmp->world);
+    }
+
+    // write restart on nwrite ranks, read it back on nread ranks
+
+    void roundtrip(int nwrite, int nread, const std::string &options)
+    {
+        bigint natoms = 0, tagsum = 0, newsum = 0;
+        double xsum = 0.0, newx = 0.0;
+        int nbad = 0;
+
+        create(nwrite);
+        if (lmp) {
+            init_system();
+            if (!verbose) ::testing::internal::CaptureStdout();
+            command("write_restart chunk.restart");
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            natoms = lmp->atom->natoms;
+            checksum(tagsum, xsum, nbad);
+        }
+        destroy();
+        MPI_Bcast(&natoms, 1, MPI_LMP_BIGINT, 0, MPI_COMM_WORLD);
+        MPI_Bcast(&tagsum, 1, MPI_LMP_BIGINT, 0, MPI_COMM_WORLD);
+        MPI_Bcast(&xsum, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+        create(nread);
+        if (lmp) {
+            EXPECT_EQ(lmp->comm->nprocs, nread);
+            if (!verbose) ::testing::internal::CaptureStdout();
+            command("read_restart chunk.restart " + options);
+            if (!verbose) ::testing::internal::GetCapturedStdout();
+            checksum(newsum, newx, nbad);
+            EXPECT_EQ(lmp->atom->natoms, natoms);
+            EXPECT_EQ(newsum, tagsum);
+            EXPECT_NEAR(newx, xsum, 1.0e-10 * fabs(xsum));
+            EXPECT_EQ(nbad, 0);
+        }
+        destroy();
+    }
+};
+
+TEST_F(MPIRestartTest, fewer_ranks)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    roundtrip(4, 2, "");
+    roundtrip(4, 3, "");
+}
+
+TEST_F(MPIRestartTest, more_ranks)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    roundtrip(1, 4, "");
+    roundtrip(3, 4, "");
+}
+
+TEST_F(MPIRestartTest, noremap)
+{
+    if (nprocs < 4) GTEST_SKIP();
+    roundtrip(4, 2, "noremap");
+    roundtrip(2, 4, "noremap");
+}
+
+} // namespace LAMMPS_NS